@@ -0,0 +1,87 @@
+#include "Core/TrackedContactCache.h"
+
+namespace TrackedCore
+{
+    void FContactCache::Resize(int numUnits)
+    {
+        TracedRequest.assign(numUnits, FSweepRequest());
+        PlanePoint.assign(numUnits, FVec3());
+        PlaneNormal.assign(numUnits, FVec3());
+        SurfaceType.assign(numUnits, 0);
+        Valid.assign(numUnits, 0);
+        Age.assign(numUnits, 0);
+        Reused.assign(numUnits, 0);
+
+        PendingSweeps.Requests.reserve(numUnits);
+        PendingSweeps.Hits.reserve(numUnits);
+        PendingTraces.reserve(numUnits);
+        PendingCacheable.reserve(numUnits);
+    }
+
+    void FContactCache::InvalidateAll()
+    {
+        Valid.assign(Valid.size(), 0);
+        Reused.assign(Reused.size(), 0);
+    }
+
+    void FContactCache::Prepare(FSweepBatch& traces, const std::vector<int>& tracedUnits, const FContactCacheSettings& settings)
+    {
+        const float maxMoveSquared = settings.MaxSegmentMove * settings.MaxSegmentMove;
+
+        PendingTraces.clear();
+        Reused.assign(Reused.size(), 0);
+
+        for(int trace = 0; trace < traces.Num(); trace++)
+        {
+            const int unit = tracedUnits[trace];
+            const FSweepRequest& request = traces.Requests[trace];
+            const FSweepRequest& traced = TracedRequest[unit];
+
+            const bool reusable = Valid[unit]
+                && Age[unit] < settings.MaxReuseTicks
+                && request.Radius == traced.Radius
+                && (request.Start - traced.Start).SizeSquared() <= maxMoveSquared
+                && (request.End - traced.End).SizeSquared() <= maxMoveSquared;
+
+            // A wheel leaving the cached plane may land on anything, trace it
+            if(reusable && sweepSphereAgainstPlane(request, PlanePoint[unit], PlaneNormal[unit], SurfaceType[unit], traces.Hits[trace]))
+            {
+                Age[unit]++;
+                Reused[unit] = 1;
+                continue;
+            }
+
+            PendingTraces.push_back(trace);
+        }
+
+        const int pending = (int)PendingTraces.size();
+        PendingSweeps.Reset(pending);
+        PendingCacheable.assign(pending, 1);
+        for(int sweep = 0; sweep < pending; sweep++)
+        {
+            PendingSweeps.Requests[sweep] = traces.Requests[PendingTraces[sweep]];
+        }
+    }
+
+    void FContactCache::Resolve(FSweepBatch& traces, const std::vector<int>& tracedUnits)
+    {
+        for(int sweep = 0; sweep < PendingSweeps.Num(); sweep++)
+        {
+            const int trace = PendingTraces[sweep];
+            const int unit = tracedUnits[trace];
+            const FSweepHit& hit = PendingSweeps.Hits[sweep];
+
+            traces.Hits[trace] = hit;
+
+            Valid[unit] = hit.bHit && PendingCacheable[sweep];
+            if(Valid[unit])
+            {
+                TracedRequest[unit] = PendingSweeps.Requests[sweep];
+                PlanePoint[unit] = hit.ImpactPoint;
+                PlaneNormal[unit] = hit.ImpactNormal;
+                SurfaceType[unit] = hit.SurfaceType;
+                Age[unit] = 0;
+            }
+        }
+    }
+}
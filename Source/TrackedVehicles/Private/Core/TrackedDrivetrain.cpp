@@ -0,0 +1,21 @@
+#include "Core/TrackedDrivetrain.h"
+
+namespace TrackedCore
+{
+    FFrictionMu getMuFromFrictionEllipse(
+        const FVec3& velocityDirection,
+        const FVec3& forwardVector,
+        float muXStatic,
+        float muYStatic,
+        float muXKinetic,
+        float muYKinetic)
+    {
+        float cosine = dot(velocityDirection, forwardVector);
+        float sine = std::sqrt(std::fmax(0.0f, 1.0f - cosine * cosine));
+
+        FFrictionMu mu;
+        mu.Static = std::sqrt((muXStatic * cosine) * (muXStatic * cosine) + (muYStatic * sine) * (muYStatic * sine));
+        mu.Kinetic = std::sqrt((muXKinetic * cosine) * (muXKinetic * cosine) + (muYKinetic * sine) * (muYKinetic * sine));
+        return mu;
+    }
+}
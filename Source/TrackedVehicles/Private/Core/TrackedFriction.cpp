@@ -0,0 +1,345 @@
+#include "Core/TrackedFriction.h"
+#include "Core/TrackedDrivetrain.h"
+#include "Core/TrackedSuspensionKernel.h"
+#include <cassert>
+
+#if defined(TRACKEDCORE_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(TRACKEDCORE_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+
+namespace TrackedCore
+{
+    void FFrictionContactBatch::Reserve(int count)
+    {
+        for(std::vector<float>* lane : { &NormalX, &NormalY, &NormalZ, &SlipX, &SlipY, &SlipZ,
+                                         &SuspensionForceX, &SuspensionForceY, &SuspensionForceZ,
+                                         &DriveX, &DriveY, &DriveZ, &MuXStatic, &MuYStatic, &MuXKinetic, &MuYKinetic,
+                                         &RollingFrictionCoef, &ForceX, &ForceY, &ForceZ, &FrictionAlongForward, &WheelLoad })
+        {
+            lane->reserve(count);
+        }
+        Unit.reserve(count);
+    }
+
+    void FFrictionContactBatch::Resize(int count)
+    {
+        for(std::vector<float>* lane : { &NormalX, &NormalY, &NormalZ, &SlipX, &SlipY, &SlipZ,
+                                         &SuspensionForceX, &SuspensionForceY, &SuspensionForceZ,
+                                         &DriveX, &DriveY, &DriveZ, &MuXStatic, &MuYStatic, &MuXKinetic, &MuYKinetic,
+                                         &RollingFrictionCoef, &ForceX, &ForceY, &ForceZ, &FrictionAlongForward, &WheelLoad })
+        {
+            lane->resize(count);
+        }
+        Unit.resize(count);
+    }
+
+    void FFrictionContactBatch::Set(int contact, int unit, const FVec3& normal, const FVec3& slip, const FVec3& suspensionForce, const FVec3& drive, const FSurfaceParams& surface)
+    {
+        Unit[contact] = unit;
+        NormalX[contact] = normal.X; NormalY[contact] = normal.Y; NormalZ[contact] = normal.Z;
+        SlipX[contact] = slip.X; SlipY[contact] = slip.Y; SlipZ[contact] = slip.Z;
+        SuspensionForceX[contact] = suspensionForce.X; SuspensionForceY[contact] = suspensionForce.Y; SuspensionForceZ[contact] = suspensionForce.Z;
+        DriveX[contact] = drive.X; DriveY[contact] = drive.Y; DriveZ[contact] = drive.Z;
+        MuXStatic[contact] = surface.MuXStatic; MuYStatic[contact] = surface.MuYStatic;
+        MuXKinetic[contact] = surface.MuXKinetic; MuYKinetic[contact] = surface.MuYKinetic;
+        RollingFrictionCoef[contact] = surface.RollingFrictionCoef;
+    }
+
+    namespace
+    {
+        // Lane types share one kernel body, so SIMD lanes and the scalar remainder
+        // run the very same sequence of IEEE operations.
+        struct FLane1
+        {
+            typedef bool FMask;
+            static const int Width = 1;
+            float V;
+
+            static FLane1 Load(const float* p) { FLane1 lane; lane.V = *p; return lane; }
+            static FLane1 Set(float v) { FLane1 lane; lane.V = v; return lane; }
+            void Store(float* p) const { *p = V; }
+
+            friend FLane1 operator+(FLane1 a, FLane1 b) { return Set(a.V + b.V); }
+            friend FLane1 operator-(FLane1 a, FLane1 b) { return Set(a.V - b.V); }
+            friend FLane1 operator*(FLane1 a, FLane1 b) { return Set(a.V * b.V); }
+            friend FLane1 operator/(FLane1 a, FLane1 b) { return Set(a.V / b.V); }
+            friend FLane1 laneSqrt(FLane1 a) { return Set(std::sqrt(a.V)); }
+            friend FLane1 laneMax(FLane1 a, FLane1 b) { return Set(a.V > b.V ? a.V : b.V); }
+            friend FLane1 laneAbs(FLane1 a) { return Set(std::fabs(a.V)); }
+            friend FMask laneLess(FLane1 a, FLane1 b) { return a.V < b.V; }
+            friend FMask laneGreaterEqual(FLane1 a, FLane1 b) { return a.V >= b.V; }
+            friend FLane1 laneSelect(FMask mask, FLane1 a, FLane1 b) { return mask ? a : b; }
+        };
+
+#if defined(TRACKEDCORE_SIMD_AVX2)
+        struct FLaneSimd
+        {
+            typedef __m256 FMask;
+            static const int Width = 8;
+            __m256 V;
+
+            static FLaneSimd Load(const float* p) { FLaneSimd lane; lane.V = _mm256_loadu_ps(p); return lane; }
+            static FLaneSimd Set(float v) { FLaneSimd lane; lane.V = _mm256_set1_ps(v); return lane; }
+            static FLaneSimd Make(__m256 v) { FLaneSimd lane; lane.V = v; return lane; }
+            void Store(float* p) const { _mm256_storeu_ps(p, V); }
+
+            friend FLaneSimd operator+(FLaneSimd a, FLaneSimd b) { return Make(_mm256_add_ps(a.V, b.V)); }
+            friend FLaneSimd operator-(FLaneSimd a, FLaneSimd b) { return Make(_mm256_sub_ps(a.V, b.V)); }
+            friend FLaneSimd operator*(FLaneSimd a, FLaneSimd b) { return Make(_mm256_mul_ps(a.V, b.V)); }
+            friend FLaneSimd operator/(FLaneSimd a, FLaneSimd b) { return Make(_mm256_div_ps(a.V, b.V)); }
+            friend FLaneSimd laneSqrt(FLaneSimd a) { return Make(_mm256_sqrt_ps(a.V)); }
+            // max(a, b) of the scalar lane returns b on ties and NaN, as _mm256_max_ps does
+            friend FLaneSimd laneMax(FLaneSimd a, FLaneSimd b) { return Make(_mm256_max_ps(a.V, b.V)); }
+            friend FLaneSimd laneAbs(FLaneSimd a) { return Make(_mm256_andnot_ps(_mm256_set1_ps(-0.0f), a.V)); }
+            friend FMask laneLess(FLaneSimd a, FLaneSimd b) { return _mm256_cmp_ps(a.V, b.V, _CMP_LT_OQ); }
+            friend FMask laneGreaterEqual(FLaneSimd a, FLaneSimd b) { return _mm256_cmp_ps(a.V, b.V, _CMP_GE_OQ); }
+            friend FLaneSimd laneSelect(FMask mask, FLaneSimd a, FLaneSimd b) { return Make(_mm256_blendv_ps(b.V, a.V, mask)); }
+        };
+#elif defined(TRACKEDCORE_SIMD_SSE2)
+        struct FLaneSimd
+        {
+            typedef __m128 FMask;
+            static const int Width = 4;
+            __m128 V;
+
+            static FLaneSimd Load(const float* p) { FLaneSimd lane; lane.V = _mm_loadu_ps(p); return lane; }
+            static FLaneSimd Set(float v) { FLaneSimd lane; lane.V = _mm_set1_ps(v); return lane; }
+            static FLaneSimd Make(__m128 v) { FLaneSimd lane; lane.V = v; return lane; }
+            void Store(float* p) const { _mm_storeu_ps(p, V); }
+
+            friend FLaneSimd operator+(FLaneSimd a, FLaneSimd b) { return Make(_mm_add_ps(a.V, b.V)); }
+            friend FLaneSimd operator-(FLaneSimd a, FLaneSimd b) { return Make(_mm_sub_ps(a.V, b.V)); }
+            friend FLaneSimd operator*(FLaneSimd a, FLaneSimd b) { return Make(_mm_mul_ps(a.V, b.V)); }
+            friend FLaneSimd operator/(FLaneSimd a, FLaneSimd b) { return Make(_mm_div_ps(a.V, b.V)); }
+            friend FLaneSimd laneSqrt(FLaneSimd a) { return Make(_mm_sqrt_ps(a.V)); }
+            // max(a, b) of the scalar lane returns b on ties and NaN, as _mm_max_ps does
+            friend FLaneSimd laneMax(FLaneSimd a, FLaneSimd b) { return Make(_mm_max_ps(a.V, b.V)); }
+            friend FLaneSimd laneAbs(FLaneSimd a) { return Make(_mm_andnot_ps(_mm_set1_ps(-0.0f), a.V)); }
+            friend FMask laneLess(FLaneSimd a, FLaneSimd b) { return _mm_cmplt_ps(a.V, b.V); }
+            friend FMask laneGreaterEqual(FLaneSimd a, FLaneSimd b) { return _mm_cmpge_ps(a.V, b.V); }
+            friend FLaneSimd laneSelect(FMask mask, FLaneSimd a, FLaneSimd b) { return Make(_mm_or_ps(_mm_and_ps(mask, a.V), _mm_andnot_ps(mask, b.V))); }
+        };
+#endif
+
+        template <typename L>
+        struct FLaneVec
+        {
+            L X, Y, Z;
+        };
+
+        template <typename L> FLaneVec<L> makeVec(L x, L y, L z) { FLaneVec<L> v; v.X = x; v.Y = y; v.Z = z; return v; }
+        template <typename L> FLaneVec<L> loadVec(const std::vector<float>& x, const std::vector<float>& y, const std::vector<float>& z, int index)
+        {
+            return makeVec(L::Load(&x[index]), L::Load(&y[index]), L::Load(&z[index]));
+        }
+        template <typename L> FLaneVec<L> setVec(const FVec3& v) { return makeVec(L::Set(v.X), L::Set(v.Y), L::Set(v.Z)); }
+        template <typename L> FLaneVec<L> operator+(const FLaneVec<L>& a, const FLaneVec<L>& b) { return makeVec(a.X + b.X, a.Y + b.Y, a.Z + b.Z); }
+        template <typename L> FLaneVec<L> operator-(const FLaneVec<L>& a, const FLaneVec<L>& b) { return makeVec(a.X - b.X, a.Y - b.Y, a.Z - b.Z); }
+        template <typename L> FLaneVec<L> operator*(const FLaneVec<L>& a, L s) { return makeVec(a.X * s, a.Y * s, a.Z * s); }
+        template <typename L> L laneDot(const FLaneVec<L>& a, const FLaneVec<L>& b) { return a.X * b.X + a.Y * b.Y + a.Z * b.Z; }
+        template <typename L> FLaneVec<L> laneSelect(typename L::FMask mask, const FLaneVec<L>& a, const FLaneVec<L>& b)
+        {
+            return makeVec(laneSelect(mask, a.X, b.X), laneSelect(mask, a.Y, b.Y), laneSelect(mask, a.Z, b.Z));
+        }
+
+        // Same as FVector::GetSafeNormal, zero for degenerated input
+        template <typename L> FLaneVec<L> laneSafeNormal(const FLaneVec<L>& v)
+        {
+            L squareSum = laneDot(v, v);
+            L inverseSize = laneSelect(laneLess(squareSum, L::Set(1.e-8f)), L::Set(0.0f), L::Set(1.0f) / laneSqrt(squareSum));
+            return v * inverseSize;
+        }
+
+        template <typename L> FLaneVec<L> laneProjectToPlane(const FLaneVec<L>& v, const FLaneVec<L>& planeNormal)
+        {
+            return v - planeNormal * laneDot(v, planeNormal);
+        }
+
+        template <typename L>
+        void solveFrictionLanes(FFrictionContactBatch& batch, const FFrictionSolveParams& params, int index)
+        {
+            const FLaneVec<L> forward = setVec<L>(params.Forward);
+            const FLaneVec<L> right = setVec<L>(params.Right);
+            const L zero = L::Set(0.0f);
+            const L one = L::Set(1.0f);
+
+            FLaneVec<L> normal = loadVec<L>(batch.NormalX, batch.NormalY, batch.NormalZ, index);
+            FLaneVec<L> slip = loadVec<L>(batch.SlipX, batch.SlipY, batch.SlipZ, index);
+            FLaneVec<L> suspensionForce = loadVec<L>(batch.SuspensionForceX, batch.SuspensionForceY, batch.SuspensionForceZ, index);
+            FLaneVec<L> drive = loadVec<L>(batch.DriveX, batch.DriveY, batch.DriveZ, index);
+            const L muXStatic = L::Load(&batch.MuXStatic[index]);
+            const L muYStatic = L::Load(&batch.MuYStatic[index]);
+            const L muXKinetic = L::Load(&batch.MuXKinetic[index]);
+            const L muYKinetic = L::Load(&batch.MuYKinetic[index]);
+
+            // wheel load is the suspension force along the contact normal
+            L wheelLoad = laneAbs(laneDot(suspensionForce, normal));
+
+            // slip in the contact plane and its friction ellipse coefficients
+            FLaneVec<L> relativeSlip = laneProjectToPlane(slip, normal);
+            L cosine = laneDot(laneSafeNormal(relativeSlip), forward);
+            L sine = laneSqrt(laneMax(zero, one - cosine * cosine));
+            L muXs = muXStatic * cosine;
+            L muYs = muYStatic * sine;
+            L muXk = muXKinetic * cosine;
+            L muYk = muYKinetic * sine;
+            L muStatic = laneSqrt(muXs * muXs + muYs * muYs);
+            L muKinetic = laneSqrt(muXk * muXk + muYk * muYk);
+
+            // force cancelling the slip within one step, split on contact plane axes
+            FLaneVec<L> slipForce = relativeSlip * L::Set(-params.SlipToForce);
+            FLaneVec<L> contactForward = laneSafeNormal(laneProjectToPlane(forward, normal));
+            FLaneVec<L> contactRight = laneSafeNormal(laneProjectToPlane(right, normal));
+            L slipOnForward = laneDot(slipForce, contactForward);
+            L slipOnRight = laneDot(slipForce, contactRight);
+
+            FLaneVec<L> staticFriction = contactForward * (slipOnForward * muXStatic) + contactRight * (slipOnRight * muYStatic);
+            FLaneVec<L> kineticFriction = contactForward * (slipOnForward * muXKinetic) + contactRight * (slipOnRight * muYKinetic);
+
+            FLaneVec<L> contactDrive = laneProjectToPlane(drive, normal);
+            FLaneVec<L> staticForce = staticFriction + contactDrive * muXStatic;
+            FLaneVec<L> kineticForce = kineticFriction + contactDrive * muXKinetic;
+
+            // static friction holds below its limit, otherwise slide with clamped kinetic force
+            typename L::FMask sliding = laneGreaterEqual(laneSqrt(laneDot(staticForce, staticForce)), wheelLoad * muStatic);
+            L kineticLimit = wheelLoad * muKinetic;
+            L kineticSize = laneSqrt(laneDot(kineticForce, kineticForce));
+            L kineticScale = laneSelect(laneLess(kineticLimit, kineticSize), kineticLimit / kineticSize, one);
+
+            FLaneVec<L> force = laneSelect(sliding, kineticForce * kineticScale, staticForce);
+            L frictionAlongForward = laneSelect(sliding, laneDot(kineticFriction, forward) * kineticScale, laneDot(staticFriction, forward));
+
+            force.X.Store(&batch.ForceX[index]);
+            force.Y.Store(&batch.ForceY[index]);
+            force.Z.Store(&batch.ForceZ[index]);
+            frictionAlongForward.Store(&batch.FrictionAlongForward[index]);
+            wheelLoad.Store(&batch.WheelLoad[index]);
+        }
+    }
+
+    void solveContactFrictionScalar(FFrictionContactBatch& batch, const FFrictionSolveParams& params)
+    {
+        for(int index = 0; index < batch.Num(); index++)
+        {
+            solveFrictionLanes<FLane1>(batch, params, index);
+        }
+    }
+
+    void solveContactFriction(FFrictionContactBatch& batch, const FFrictionSolveParams& params)
+    {
+        int index = 0;
+
+#if defined(TRACKEDCORE_SIMD_AVX2) || defined(TRACKEDCORE_SIMD_SSE2)
+        for(; index + FLaneSimd::Width <= batch.Num(); index += FLaneSimd::Width)
+        {
+            solveFrictionLanes<FLaneSimd>(batch, params, index);
+        }
+#endif
+
+        for(; index < batch.Num(); index++)
+        {
+            solveFrictionLanes<FLane1>(batch, params, index);
+        }
+    }
+
+    float averageRollingFrictionCoef(const FSuspensionStore& suspensions, const FSurfaceTable& surfaces)
+    {
+        float sum = 0.0f;
+        int engaged = 0;
+        for(int index = 0; index < suspensions.Num(); index++)
+        {
+            if(suspensions.Engaged[index])
+            {
+                sum += surfaces.Get(suspensions.HitMaterial[index]).RollingFrictionCoef;
+                engaged++;
+            }
+        }
+        return engaged ? sum / engaged : surfaces.Get(0).RollingFrictionCoef;
+    }
+
+    void solveTrackFriction(
+        const FSuspensionStore& suspensions,
+        const FVehicleFrame& frame,
+        const FTrackFrictionParams& params,
+        const FTrackFrictionInputs& inputs,
+        FFrictionContactBatch& batch,
+        FForceAccumulator& bodyForces,
+        FTrackFrictionResult& outResult)
+    {
+        assert(params.Surfaces);
+
+        outResult = FTrackFrictionResult();
+
+        int leftContacts = 0;
+        int rightContacts = 0;
+        for(int index = 0; index < suspensions.Num(); index++)
+        {
+            if(suspensions.Engaged[index])
+            {
+                (suspensions.SideOf(index) == ETrackSide::Left ? leftContacts : rightContacts)++;
+            }
+        }
+
+        outResult.NumContacts = leftContacts + rightContacts;
+        if(outResult.NumContacts == 0 || inputs.DT <= 0.0f)
+        {
+            batch.Resize(0);
+            return;
+        }
+        batch.Resize(outResult.NumContacts);
+
+        // Drive force of a track is shared by its contacts
+        FVec3 driveLeft = leftContacts ? frame.Forward * (inputs.DriveTorqueLeft / params.SprocketRadiusCm / leftContacts) : FVec3();
+        FVec3 driveRight = rightContacts ? frame.Forward * (inputs.DriveTorqueRight / params.SprocketRadiusCm / rightContacts) : FVec3();
+        FVec3 trackVelocityLeft = frame.Forward * inputs.TrackLinVelLeft;
+        FVec3 trackVelocityRight = frame.Forward * inputs.TrackLinVelRight;
+
+        int contact = 0;
+        for(int index = 0; index < suspensions.Num(); index++)
+        {
+            if(!suspensions.Engaged[index])
+            {
+                continue;
+            }
+
+            const bool left = suspensions.SideOf(index) == ETrackSide::Left;
+            FVec3 slip = frame.VelocityAtLocation(suspensions.ContactPoint[index]) - (left ? trackVelocityLeft : trackVelocityRight);
+            batch.Set(contact++, index, safeNormal(suspensions.ContactNormal[index]), slip, suspensions.Force[index], left ? driveLeft : driveRight,
+                      params.Surfaces->Get(suspensions.HitMaterial[index]));
+        }
+
+        FFrictionSolveParams solveParams;
+        solveParams.Forward = frame.Forward;
+        solveParams.Right = frame.Right;
+        solveParams.SlipToForce = frame.Mass / inputs.DT / (float)outResult.NumContacts;
+
+        solveContactFriction(batch, solveParams);
+
+        // Rolling resistance weighted by the load on each surface
+        float rollingLoadLeft = 0.0f;
+        float rollingLoadRight = 0.0f;
+        for(int contact = 0; contact < batch.Num(); contact++)
+        {
+            const int unit = batch.Unit[contact];
+            bodyForces.AddForceAtLocation(FVec3(batch.ForceX[contact], batch.ForceY[contact], batch.ForceZ[contact]), suspensions.ContactPoint[unit]);
+
+            // ground pushes the body forward, the track is dragged back by the same force
+            float trackTorque = -batch.FrictionAlongForward[contact] * params.SprocketRadiusCm;
+            if(suspensions.SideOf(unit) == ETrackSide::Left)
+            {
+                outResult.FrictionTorqueLeft += trackTorque;
+                rollingLoadLeft += batch.WheelLoad[contact] * batch.RollingFrictionCoef[contact];
+            }
+            else
+            {
+                outResult.FrictionTorqueRight += trackTorque;
+                rollingLoadRight += batch.WheelLoad[contact] * batch.RollingFrictionCoef[contact];
+            }
+        }
+
+        outResult.RollingFrictionTorqueLeft = calculateRollingFrictionTorque(inputs.TrackAngVelLeft, rollingLoadLeft, 1.0f, params.SprocketRadiusCm);
+        outResult.RollingFrictionTorqueRight = calculateRollingFrictionTorque(inputs.TrackAngVelRight, rollingLoadRight, 1.0f, params.SprocketRadiusCm);
+    }
+}
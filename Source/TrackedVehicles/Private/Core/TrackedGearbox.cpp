@@ -0,0 +1,127 @@
+#include "Core/TrackedGearbox.h"
+
+namespace TrackedCore
+{
+    void FGearbox::Build(const float* ratios, int numRatios, float diferentialRatio, float minRPM, float maxRPM, const FGearboxSettings& settings)
+    {
+        Settings = settings;
+        Ratios.assign(ratios, ratios + numRatios);
+        UpShiftAxleVel.assign(numRatios, 0.0f);
+        DownShiftAxleVel.assign(numRatios, 0.0f);
+
+        NeutralGear = -1;
+        FirstForwardGear = -1;
+        FirstReverseGear = -1;
+        for(int gear = 0; gear < numRatios; gear++)
+        {
+            if(Ratios[gear] < 0.0f)
+            {
+                // Closest to neutral is the last negative one
+                FirstReverseGear = gear;
+            }
+            else if(Ratios[gear] == 0.0f)
+            {
+                NeutralGear = NeutralGear < 0 ? gear : NeutralGear;
+            }
+            else if(FirstForwardGear < 0)
+            {
+                FirstForwardGear = gear;
+            }
+        }
+
+        const float rpmRange = maxRPM - minRPM;
+        for(int gear = 0; gear < numRatios; gear++)
+        {
+            const float ratio = GetRatio(gear);
+            UpShiftAxleVel[gear] = axleAngVelFromEngineRPM(minRPM + rpmRange * settings.UpShiftPrc, ratio, diferentialRatio);
+            DownShiftAxleVel[gear] = axleAngVelFromEngineRPM(minRPM + rpmRange * settings.DownShiftPrc, ratio, diferentialRatio);
+        }
+
+        ApplyHysteresis();
+    }
+
+    void FGearbox::ApplyHysteresis()
+    {
+        // A gear never shifts back down before the axle slowed well under its own up shift point
+        for(int gear = 0; gear < (int)Ratios.size(); gear++)
+        {
+            const int next = NextGear(gear);
+            if(next != gear && Ratios[gear] != 0.0f)
+            {
+                DownShiftAxleVel[next] = std::fmin(DownShiftAxleVel[next], UpShiftAxleVel[gear] * (1.0f - Settings.Hysteresis));
+            }
+        }
+    }
+
+    int FGearbox::NextGear(int gear) const
+    {
+        if(IsForward(gear))
+        {
+            return IsForward(gear + 1) ? gear + 1 : gear;
+        }
+        if(IsReverse(gear))
+        {
+            return IsReverse(gear - 1) ? gear - 1 : gear;
+        }
+        return gear;
+    }
+
+    int FGearbox::PreviousGear(int gear) const
+    {
+        if(IsForward(gear))
+        {
+            return IsForward(gear - 1) ? gear - 1 : gear;
+        }
+        if(IsReverse(gear))
+        {
+            return IsReverse(gear + 1) ? gear + 1 : gear;
+        }
+        return gear;
+    }
+
+    void updateAutomaticGear(const FGearbox& gearbox, FGearboxState& state, float axleAngVel, float travelAngVel, float driveDirection, float dt)
+    {
+        if(!gearbox.IsValid())
+        {
+            return;
+        }
+        if(state.Gear < 0 || state.Gear >= (int)gearbox.Ratios.size())
+        {
+            state.Gear = gearbox.GetStartGear();
+        }
+
+        state.TimeSinceShift += dt;
+
+        // Direction changes wait until the vehicle (nearly) stopped or already rolls that way
+        const bool canGoForward = travelAngVel > -gearbox.Settings.StopAngVel;
+        const bool canGoBackward = travelAngVel < gearbox.Settings.StopAngVel;
+        int gear = state.Gear;
+
+        if(driveDirection > 0.0f && !gearbox.IsForward(gear) && canGoForward)
+        {
+            gear = gearbox.FirstForwardGear;
+        }
+        else if(driveDirection < 0.0f && !gearbox.IsReverse(gear) && canGoBackward && gearbox.FirstReverseGear >= 0)
+        {
+            gear = gearbox.FirstReverseGear;
+        }
+        else if(state.TimeSinceShift >= gearbox.Settings.ShiftDelay)
+        {
+            if(axleAngVel > gearbox.UpShiftAxleVel[gear])
+            {
+                gear = gearbox.NextGear(gear);
+            }
+            else if(axleAngVel < gearbox.DownShiftAxleVel[gear])
+            {
+                gear = gearbox.PreviousGear(gear);
+            }
+        }
+
+        if(gear != state.Gear)
+        {
+            state.Gear = gear;
+            state.TimeSinceShift = 0.0f;
+        }
+        state.bReverse = gearbox.IsReverse(state.Gear);
+    }
+}
@@ -0,0 +1,44 @@
+#include "Core/TrackedGroundQuery.h"
+
+namespace TrackedCore
+{
+    bool sweepSphereAgainstPlane(const FSweepRequest& request, const FVec3& planePoint, const FVec3& planeNormal, uint8_t surfaceType, FSweepHit& outHit)
+    {
+        // signed distance of the sphere surface to the plane along the sweep
+        float startDistance = dot(request.Start - planePoint, planeNormal) - request.Radius;
+        float endDistance = dot(request.End - planePoint, planeNormal) - request.Radius;
+
+        if(startDistance > 0.0f && endDistance > 0.0f)
+        {
+            return false;
+        }
+
+        // initial overlap reports the start location, as the physics sweep does
+        float time = startDistance <= 0.0f ? 0.0f : startDistance / (startDistance - endDistance);
+
+        outHit.bHit = true;
+        outHit.Location = request.Start + (request.End - request.Start) * time;
+        outHit.ImpactNormal = planeNormal;
+        outHit.ImpactPoint = outHit.Location - planeNormal * request.Radius;
+        outHit.SurfaceType = surfaceType;
+        return true;
+    }
+
+    FFlatGroundQuery::FFlatGroundQuery(const FVec3& planePoint, const FVec3& planeNormal, uint8_t surfaceType)
+        : PlanePoint(planePoint)
+        , PlaneNormal(safeNormal(planeNormal))
+        , SurfaceType(surfaceType)
+    {
+    }
+
+    void FFlatGroundQuery::SweepBatch(const FSweepRequest* requests, FSweepHit* hits, int count)
+    {
+        for(int index = 0; index < count; index++)
+        {
+            if(!sweepSphereAgainstPlane(requests[index], PlanePoint, PlaneNormal, SurfaceType, hits[index]))
+            {
+                hits[index].bHit = false;
+            }
+        }
+    }
+}
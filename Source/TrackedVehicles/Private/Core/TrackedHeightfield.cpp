@@ -0,0 +1,119 @@
+#include "Core/TrackedHeightfield.h"
+
+namespace TrackedCore
+{
+    bool FHeightfield::Sample(float worldX, float worldY, float& outHeight, FVec3& outNormal, uint8_t& outSurfaceType) const
+    {
+        const float gridX = (worldX - Origin.X) / CellSize;
+        const float gridY = (worldY - Origin.Y) / CellSize;
+
+        // Written so NaN fails too
+        if(!(gridX >= 0.0f && gridY >= 0.0f && gridX <= (float)(NumX - 1) && gridY <= (float)(NumY - 1)))
+        {
+            return false;
+        }
+
+        // The last row and column belong to the cell before them
+        const int x = (int)gridX < NumX - 2 ? (int)gridX : NumX - 2;
+        const int y = (int)gridY < NumY - 2 ? (int)gridY : NumY - 2;
+        const float alphaX = gridX - (float)x;
+        const float alphaY = gridY - (float)y;
+
+        const size_t index = (size_t)y * NumX + x;
+        const float h00 = Heights[index];
+        const float h10 = Heights[index + 1];
+        const float h01 = Heights[index + NumX];
+        const float h11 = Heights[index + NumX + 1];
+
+        const float bottom = h00 + (h10 - h00) * alphaX;
+        const float top = h01 + (h11 - h01) * alphaX;
+        outHeight = Origin.Z + bottom + (top - bottom) * alphaY;
+
+        // Slopes of the bilinear patch at the point
+        const float slopeX = ((h10 - h00) * (1.0f - alphaY) + (h11 - h01) * alphaY) / CellSize;
+        const float slopeY = (top - bottom) / CellSize;
+        outNormal = safeNormal(FVec3(-slopeX, -slopeY, 1.0f));
+
+        if(SurfaceTypes.empty())
+        {
+            outSurfaceType = DefaultSurfaceType;
+        }
+        else
+        {
+            const size_t nearest = index + (alphaY >= 0.5f ? NumX : 0) + (alphaX >= 0.5f ? 1 : 0);
+            outSurfaceType = nearest < SurfaceTypes.size() ? SurfaceTypes[nearest] : DefaultSurfaceType;
+        }
+        return true;
+    }
+
+    bool sweepSphereAgainstHeightfield(const FSweepRequest& request, const FHeightfield& heightfield, FSweepHit& outHit)
+    {
+        const int refinements = 2;
+        const float settleDistance = heightfield.CellSize * 0.01f;
+        const float settleDistanceSquared = settleDistance * settleDistance;
+
+        FSweepHit hit;
+        float probeX = request.Start.X;
+        float probeY = request.Start.Y;
+
+        for(int pass = 0; pass <= refinements; pass++)
+        {
+            float height;
+            FVec3 normal;
+            uint8_t surfaceType;
+            if(!heightfield.Sample(probeX, probeY, height, normal, surfaceType))
+            {
+                // Contact slid off the grid, keep the last patch that had one
+                if(pass == 0)
+                {
+                    return false;
+                }
+                break;
+            }
+
+            if(!sweepSphereAgainstPlane(request, FVec3(probeX, probeY, height), normal, surfaceType, hit))
+            {
+                return false;
+            }
+
+            // Contact stayed on the sampled point, the plane would not change
+            const float moveX = hit.ImpactPoint.X - probeX;
+            const float moveY = hit.ImpactPoint.Y - probeY;
+            if(moveX * moveX + moveY * moveY < settleDistanceSquared)
+            {
+                break;
+            }
+
+            probeX = hit.ImpactPoint.X;
+            probeY = hit.ImpactPoint.Y;
+        }
+
+        outHit = hit;
+        return true;
+    }
+
+    FHeightfieldGroundQuery::FHeightfieldGroundQuery(const FHeightfield& heightfield)
+        : Heightfield(heightfield)
+    {
+    }
+
+    void FHeightfieldGroundQuery::SweepBatch(const FSweepRequest* requests, FSweepHit* hits, int count)
+    {
+        if(!Heightfield.IsValid())
+        {
+            for(int index = 0; index < count; index++)
+            {
+                hits[index].bHit = false;
+            }
+            return;
+        }
+
+        for(int index = 0; index < count; index++)
+        {
+            if(!sweepSphereAgainstHeightfield(requests[index], Heightfield, hits[index]))
+            {
+                hits[index].bHit = false;
+            }
+        }
+    }
+}
@@ -0,0 +1,314 @@
+#include "Core/TrackedNetState.h"
+
+namespace TrackedCore
+{
+    namespace
+    {
+        // Units per vehicle a snapshot can carry
+        const int SuspensionCountBits = 6;
+        const int GearBits = 4;
+
+        uint32_t maxQuantized(int bits)
+        {
+            return (1u << bits) - 1u;
+        }
+
+        // NaN and inf quantize to zero, neither survives the clamp nor the integer conversion
+        uint32_t quantizeUnit(float value, int bits)
+        {
+            const float clamped = std::isfinite(value) ? fclamp(value, 0.0f, 1.0f) : 0.0f;
+            return (uint32_t)(clamped * (float)maxQuantized(bits) + 0.5f);
+        }
+
+        float dequantizeUnit(uint32_t value, int bits)
+        {
+            return (float)value / (float)maxQuantized(bits);
+        }
+
+        // Zero maps to the middle value exactly, so a stopped track stays stopped
+        uint32_t quantizeSigned(float value, float range, int bits)
+        {
+            const int32_t half = (int32_t)maxQuantized(bits - 1);
+            const float scaled = range > 0.0f && std::isfinite(value) ? fclamp(value / range, -1.0f, 1.0f) * (float)half : 0.0f;
+            return (uint32_t)((int32_t)std::lround(scaled) + half);
+        }
+
+        float dequantizeSigned(uint32_t value, float range, int bits)
+        {
+            const int32_t half = (int32_t)maxQuantized(bits - 1);
+            return (float)((int32_t)value - half) / (float)half * range;
+        }
+
+        // Against a baseline a field is a changed bit, followed by the value only when it changed
+        void writeField(FNetBitWriter& writer, uint32_t value, bool delta, uint32_t baselineValue, int bits)
+        {
+            if(delta)
+            {
+                writer.WriteBool(value != baselineValue);
+                if(value == baselineValue)
+                {
+                    return;
+                }
+            }
+            writer.WriteBits(value, bits);
+        }
+
+        uint32_t readField(FNetBitReader& reader, bool delta, uint32_t baselineValue, int bits)
+        {
+            if(delta && !reader.ReadBool())
+            {
+                return baselineValue;
+            }
+            return reader.ReadBits(bits);
+        }
+    }
+
+    void FNetBitWriter::WriteBits(uint32_t value, int bits)
+    {
+        for(int bit = 0; bit < bits; bit++)
+        {
+            if((NumBits & 7) == 0)
+            {
+                Bytes.push_back(0);
+            }
+            if(value & (1u << bit))
+            {
+                Bytes.back() |= (uint8_t)(1u << (NumBits & 7));
+            }
+            NumBits++;
+        }
+    }
+
+    uint32_t FNetBitReader::ReadBits(int bits)
+    {
+        if(bOverflow || Position + bits > NumBits)
+        {
+            bOverflow = true;
+            return 0;
+        }
+
+        uint32_t value = 0;
+        for(int bit = 0; bit < bits; bit++)
+        {
+            if(Data[Position >> 3] & (1u << (Position & 7)))
+            {
+                value |= 1u << bit;
+            }
+            Position++;
+        }
+        return value;
+    }
+
+    bool FVehicleNetSnapshot::IsStateEqual(const FVehicleNetSnapshot& other) const
+    {
+        return LastInput == other.LastInput
+            && TrackLeftAngVel == other.TrackLeftAngVel
+            && TrackRightAngVel == other.TrackRightAngVel
+            && Throttle == other.Throttle
+            && EngineRPM == other.EngineRPM
+            && InputLeft == other.InputLeft
+            && InputRight == other.InputRight
+            && Gear == other.Gear
+            && bReverse == other.bReverse
+            && bAsleep == other.bAsleep
+            && SuspensionLength == other.SuspensionLength;
+    }
+
+    void quantizeNetState(const FNetVehicleState& state, const FSuspensionStore& store, const FNetQuantization& quantization, FVehicleNetSnapshot& outSnapshot)
+    {
+        outSnapshot.TrackLeftAngVel = quantizeSigned(state.TrackLeftAngVel, quantization.MaxTrackAngVel, quantization.TrackAngVelBits);
+        outSnapshot.TrackRightAngVel = quantizeSigned(state.TrackRightAngVel, quantization.MaxTrackAngVel, quantization.TrackAngVelBits);
+        outSnapshot.Throttle = quantizeUnit(state.Throttle, quantization.ThrottleBits);
+        outSnapshot.EngineRPM = quantizeUnit(quantization.MaxEngineRPM > 0.0f ? state.EngineRPM / quantization.MaxEngineRPM : 0.0f, quantization.EngineRPMBits);
+        outSnapshot.InputLeft = quantizeSigned(state.InputLeft, 1.0f, quantization.InputBits);
+        outSnapshot.InputRight = quantizeSigned(state.InputRight, 1.0f, quantization.InputBits);
+        outSnapshot.Gear = (uint32_t)fclamp(state.Gear + 1, 0, (int)maxQuantized(GearBits));
+        outSnapshot.bReverse = state.bReverse;
+        outSnapshot.bAsleep = state.bAsleep;
+
+        const int count = store.Num() < (int)maxQuantized(SuspensionCountBits) ? store.Num() : (int)maxQuantized(SuspensionCountBits);
+        outSnapshot.SuspensionLength.resize(count);
+        for(int unit = 0; unit < count; unit++)
+        {
+            const float ratio = store.Length[unit] > Epsilon ? store.PreviousLength[unit] / store.Length[unit] : 0.0f;
+            outSnapshot.SuspensionLength[unit] = (uint8_t)quantizeUnit(ratio, quantization.SuspensionBits);
+        }
+    }
+
+    void dequantizeNetState(const FVehicleNetSnapshot& snapshot, const FNetQuantization& quantization, FNetVehicleState& outState, FSuspensionStore& store)
+    {
+        outState.TrackLeftAngVel = dequantizeSigned(snapshot.TrackLeftAngVel, quantization.MaxTrackAngVel, quantization.TrackAngVelBits);
+        outState.TrackRightAngVel = dequantizeSigned(snapshot.TrackRightAngVel, quantization.MaxTrackAngVel, quantization.TrackAngVelBits);
+        outState.Throttle = dequantizeUnit(snapshot.Throttle, quantization.ThrottleBits);
+        outState.EngineRPM = dequantizeUnit(snapshot.EngineRPM, quantization.EngineRPMBits) * quantization.MaxEngineRPM;
+        outState.InputLeft = dequantizeSigned(snapshot.InputLeft, 1.0f, quantization.InputBits);
+        outState.InputRight = dequantizeSigned(snapshot.InputRight, 1.0f, quantization.InputBits);
+        outState.Gear = (int)snapshot.Gear - 1;
+        outState.bReverse = snapshot.bReverse;
+        outState.bAsleep = snapshot.bAsleep;
+
+        // A unit count mismatch means another vehicle setup, keep the local lengths
+        if((int)snapshot.SuspensionLength.size() != store.Num())
+        {
+            return;
+        }
+        for(int unit = 0; unit < store.Num(); unit++)
+        {
+            store.PreviousLength[unit] = dequantizeUnit(snapshot.SuspensionLength[unit], quantization.SuspensionBits) * store.Length[unit];
+        }
+    }
+
+    void FNetSnapshotHistory::Reset()
+    {
+        for(int index = 0; index < Capacity; index++)
+        {
+            Valid[index] = false;
+        }
+        Next = 0;
+    }
+
+    void FNetSnapshotHistory::Add(const FVehicleNetSnapshot& snapshot)
+    {
+        // Slots keep their vector capacity, steady state adds do not allocate
+        Snapshots[Next] = snapshot;
+        Valid[Next] = true;
+        Next = (Next + 1) % Capacity;
+    }
+
+    const FVehicleNetSnapshot* FNetSnapshotHistory::Find(uint16_t sequence) const
+    {
+        for(int index = 0; index < Capacity; index++)
+        {
+            if(Valid[index] && Snapshots[index].Sequence == sequence)
+            {
+                return &Snapshots[index];
+            }
+        }
+        return nullptr;
+    }
+
+    void writeNetSnapshot(FNetBitWriter& writer, const FVehicleNetSnapshot& snapshot, const FVehicleNetSnapshot* baseline, const FNetQuantization& quantization)
+    {
+        const bool delta = baseline != nullptr;
+        const FVehicleNetSnapshot empty;
+        const FVehicleNetSnapshot& base = delta ? *baseline : empty;
+
+        writer.WriteBits(snapshot.Sequence, 16);
+        writer.WriteBool(delta);
+        if(delta)
+        {
+            writer.WriteBits(base.Sequence, 16);
+        }
+
+        writeField(writer, snapshot.LastInput, delta, base.LastInput, 16);
+        writeField(writer, snapshot.TrackLeftAngVel, delta, base.TrackLeftAngVel, quantization.TrackAngVelBits);
+        writeField(writer, snapshot.TrackRightAngVel, delta, base.TrackRightAngVel, quantization.TrackAngVelBits);
+        writeField(writer, snapshot.Throttle, delta, base.Throttle, quantization.ThrottleBits);
+        writeField(writer, snapshot.EngineRPM, delta, base.EngineRPM, quantization.EngineRPMBits);
+        writeField(writer, snapshot.InputLeft, delta, base.InputLeft, quantization.InputBits);
+        writeField(writer, snapshot.InputRight, delta, base.InputRight, quantization.InputBits);
+        writeField(writer, snapshot.Gear, delta, base.Gear, GearBits);
+        writer.WriteBool(snapshot.bReverse);
+        writer.WriteBool(snapshot.bAsleep);
+
+        // Same unit count: one bit when no unit moved, else a changed bit per unit
+        const int count = (int)snapshot.SuspensionLength.size();
+        const bool sameUnits = delta && count == (int)base.SuspensionLength.size();
+        writer.WriteBool(sameUnits);
+        if(sameUnits)
+        {
+            const bool anyMoved = snapshot.SuspensionLength != base.SuspensionLength;
+            writer.WriteBool(anyMoved);
+            for(int unit = 0; anyMoved && unit < count; unit++)
+            {
+                writeField(writer, snapshot.SuspensionLength[unit], true, base.SuspensionLength[unit], quantization.SuspensionBits);
+            }
+        }
+        else
+        {
+            writer.WriteBits((uint32_t)count, SuspensionCountBits);
+            for(int unit = 0; unit < count; unit++)
+            {
+                writer.WriteBits(snapshot.SuspensionLength[unit], quantization.SuspensionBits);
+            }
+        }
+    }
+
+    ENetSnapshotRead readNetSnapshot(FNetBitReader& reader, const FNetSnapshotHistory& baselines, const FNetQuantization& quantization, FVehicleNetSnapshot& outSnapshot)
+    {
+        const uint16_t sequence = (uint16_t)reader.ReadBits(16);
+        const bool delta = reader.ReadBool();
+
+        const FVehicleNetSnapshot* baseline = nullptr;
+        if(delta)
+        {
+            const uint16_t baselineSequence = (uint16_t)reader.ReadBits(16);
+            if(reader.IsOverflowed())
+            {
+                return ENetSnapshotRead::Corrupt;
+            }
+            baseline = baselines.Find(baselineSequence);
+            if(!baseline)
+            {
+                return ENetSnapshotRead::MissingBaseline;
+            }
+        }
+
+        const FVehicleNetSnapshot empty;
+        const FVehicleNetSnapshot& base = delta ? *baseline : empty;
+
+        outSnapshot.Sequence = sequence;
+        outSnapshot.LastInput = (uint16_t)readField(reader, delta, base.LastInput, 16);
+        outSnapshot.TrackLeftAngVel = readField(reader, delta, base.TrackLeftAngVel, quantization.TrackAngVelBits);
+        outSnapshot.TrackRightAngVel = readField(reader, delta, base.TrackRightAngVel, quantization.TrackAngVelBits);
+        outSnapshot.Throttle = readField(reader, delta, base.Throttle, quantization.ThrottleBits);
+        outSnapshot.EngineRPM = readField(reader, delta, base.EngineRPM, quantization.EngineRPMBits);
+        outSnapshot.InputLeft = readField(reader, delta, base.InputLeft, quantization.InputBits);
+        outSnapshot.InputRight = readField(reader, delta, base.InputRight, quantization.InputBits);
+        outSnapshot.Gear = readField(reader, delta, base.Gear, GearBits);
+        outSnapshot.bReverse = reader.ReadBool();
+        outSnapshot.bAsleep = reader.ReadBool();
+
+        if(reader.ReadBool())
+        {
+            outSnapshot.SuspensionLength = base.SuspensionLength;
+            if(reader.ReadBool())
+            {
+                for(int unit = 0; unit < (int)outSnapshot.SuspensionLength.size(); unit++)
+                {
+                    outSnapshot.SuspensionLength[unit] = (uint8_t)readField(reader, true, base.SuspensionLength[unit], quantization.SuspensionBits);
+                }
+            }
+        }
+        else
+        {
+            outSnapshot.SuspensionLength.resize(reader.ReadBits(SuspensionCountBits));
+            for(int unit = 0; unit < (int)outSnapshot.SuspensionLength.size(); unit++)
+            {
+                outSnapshot.SuspensionLength[unit] = (uint8_t)reader.ReadBits(quantization.SuspensionBits);
+            }
+        }
+
+        return reader.IsOverflowed() ? ENetSnapshotRead::Corrupt : ENetSnapshotRead::Ok;
+    }
+
+    void FNetInputHistory::Add(const FNetInput& input)
+    {
+        if(Count == Capacity)
+        {
+            First = (First + 1) % Capacity;
+            Count--;
+        }
+        Inputs[(First + Count) % Capacity] = input;
+        Count++;
+    }
+
+    void FNetInputHistory::Acknowledge(uint16_t sequence)
+    {
+        while(Count > 0 && !isNewerSequence(Inputs[First].Sequence, sequence))
+        {
+            First = (First + 1) % Capacity;
+            Count--;
+        }
+    }
+}
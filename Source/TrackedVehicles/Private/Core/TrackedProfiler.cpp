@@ -0,0 +1,129 @@
+#include "Core/TrackedProfiler.h"
+#include <atomic>
+#include <cstdio>
+#include <functional>
+#include <thread>
+
+namespace TrackedCore
+{
+    namespace
+    {
+        std::atomic<IProfilerSink*> GProfilerSink(nullptr);
+
+        const char* const ScopeNames[] =
+        {
+            "BeginTick",
+            "Drivetrain",
+            "GatherTraces",
+            "ExecuteTraces",
+            "ConsumeTraces",
+            "SuspensionForces",
+            "Friction",
+            "ApplyForces",
+            "GroundFollow"
+        };
+        static_assert(sizeof(ScopeNames) / sizeof(ScopeNames[0]) == (int)EProfileScope::Count, "Name every profile scope");
+
+        const char* const CounterNames[] =
+        {
+            "Traces",
+            "EngagedContacts",
+            "ForcesApplied",
+            "SleepingVehicles"
+        };
+        static_assert(sizeof(CounterNames) / sizeof(CounterNames[0]) == (int)EProfileCounter::Count, "Name every profile counter");
+    }
+
+    const char* profileScopeName(EProfileScope scope)
+    {
+        return scope < EProfileScope::Count ? ScopeNames[(int)scope] : "Unknown";
+    }
+
+    const char* profileCounterName(EProfileCounter counter)
+    {
+        return counter < EProfileCounter::Count ? CounterNames[(int)counter] : "Unknown";
+    }
+
+    void setProfilerSink(IProfilerSink* sink)
+    {
+        GProfilerSink.store(sink, std::memory_order_release);
+    }
+
+    IProfilerSink* getProfilerSink()
+    {
+        return GProfilerSink.load(std::memory_order_acquire);
+    }
+
+    FChromeTraceWriter::FChromeTraceWriter()
+        : Start(std::chrono::steady_clock::now())
+    {
+    }
+
+    void FChromeTraceWriter::BeginScope(EProfileScope scope)
+    {
+        Record('B', (uint8_t)scope, 0);
+    }
+
+    void FChromeTraceWriter::EndScope(EProfileScope scope)
+    {
+        Record('E', (uint8_t)scope, 0);
+    }
+
+    void FChromeTraceWriter::AddCounter(EProfileCounter counter, int64_t value)
+    {
+        Record('C', (uint8_t)counter, value);
+    }
+
+    void FChromeTraceWriter::Record(char phase, uint8_t id, int64_t value)
+    {
+        FEvent event;
+        event.Phase = phase;
+        event.Id = id;
+        event.Thread = (uint32_t)std::hash<std::thread::id>()(std::this_thread::get_id());
+        event.TimeNs = (int64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Start).count();
+        event.Value = value;
+
+        std::lock_guard<std::mutex> lock(Mutex);
+        Events.push_back(event);
+    }
+
+    int FChromeTraceWriter::NumEvents() const
+    {
+        std::lock_guard<std::mutex> lock(Mutex);
+        return (int)Events.size();
+    }
+
+    bool FChromeTraceWriter::Write(const char* path) const
+    {
+        FILE* file = std::fopen(path, "w");
+        if(!file)
+        {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(Mutex);
+
+        std::fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+        for(size_t index = 0; index < Events.size(); index++)
+        {
+            const FEvent& event = Events[index];
+            const char* separator = index + 1 < Events.size() ? "," : "";
+            const double timeUs = (double)event.TimeNs * 1.e-3;
+
+            if(event.Phase == 'C')
+            {
+                const char* name = profileCounterName((EProfileCounter)event.Id);
+                std::fprintf(file, "{\"name\": \"%s\", \"ph\": \"C\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f, \"args\": {\"%s\": %lld}}%s\n",
+                    name, event.Thread, timeUs, name, (long long)event.Value, separator);
+            }
+            else
+            {
+                std::fprintf(file, "{\"name\": \"%s\", \"ph\": \"%c\", \"pid\": 1, \"tid\": %u, \"ts\": %.3f}%s\n",
+                    profileScopeName((EProfileScope)event.Id), event.Phase, event.Thread, timeUs, separator);
+            }
+        }
+        std::fprintf(file, "]}\n");
+
+        return std::fclose(file) == 0;
+    }
+}
@@ -0,0 +1,770 @@
+#include "Core/TrackedReplayLog.h"
+#include <cmath>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace TrackedCore
+{
+    namespace
+    {
+        const char Magic[4] = { 'T', 'V', 'R', 'L' };
+        const size_t HeaderSize = sizeof(Magic) + sizeof(uint32_t);
+        const size_t ChunkHeaderSize = 1 + sizeof(uint32_t);
+
+        const uint8_t ChunkVehicle = 'V';
+        const uint8_t ChunkTick = 'T';
+
+        // Values are stored in host byte order, every supported target is little endian
+        template <typename T>
+        void put(std::vector<uint8_t>& out, const T& value)
+        {
+            const size_t offset = out.size();
+            out.resize(offset + sizeof(T));
+            std::memcpy(&out[offset], &value, sizeof(T));
+        }
+
+        void putVec(std::vector<uint8_t>& out, const FVec3& value)
+        {
+            put(out, value.X);
+            put(out, value.Y);
+            put(out, value.Z);
+        }
+
+        void putQuat(std::vector<uint8_t>& out, const FQuat4& value)
+        {
+            put(out, value.X);
+            put(out, value.Y);
+            put(out, value.Z);
+            put(out, value.W);
+        }
+
+        void putFloats(std::vector<uint8_t>& out, const std::vector<float>& values)
+        {
+            put(out, (uint32_t)values.size());
+            for(float value : values)
+            {
+                put(out, value);
+            }
+        }
+
+        /// Bounds checked reads, a short read leaves the value alone and fails the cursor
+        struct FCursor
+        {
+            const uint8_t* Data;
+            const uint8_t* End;
+            bool bOk = true;
+
+            template <typename T>
+            void Get(T& outValue)
+            {
+                if(!bOk || (size_t)(End - Data) < sizeof(T))
+                {
+                    bOk = false;
+                    return;
+                }
+                std::memcpy(&outValue, Data, sizeof(T));
+                Data += sizeof(T);
+            }
+
+            void GetVec(FVec3& outValue)
+            {
+                Get(outValue.X);
+                Get(outValue.Y);
+                Get(outValue.Z);
+            }
+
+            void GetQuat(FQuat4& outValue)
+            {
+                Get(outValue.X);
+                Get(outValue.Y);
+                Get(outValue.Z);
+                Get(outValue.W);
+            }
+
+            void GetFloats(std::vector<float>& outValues)
+            {
+                uint32_t count = 0;
+                Get(count);
+                if(!bOk || (size_t)(End - Data) / sizeof(float) < count)
+                {
+                    bOk = false;
+                    return;
+                }
+                outValues.resize(count);
+                for(float& value : outValues)
+                {
+                    Get(value);
+                }
+            }
+        };
+
+        void putHit(std::vector<uint8_t>& out, const FSweepHit& hit)
+        {
+            put(out, (uint8_t)(hit.bHit ? 1 : 0));
+            if(hit.bHit)
+            {
+                putVec(out, hit.Location);
+                putVec(out, hit.ImpactPoint);
+                putVec(out, hit.ImpactNormal);
+                put(out, hit.SurfaceType);
+            }
+        }
+
+        void getHit(FCursor& cursor, FSweepHit& outHit)
+        {
+            uint8_t hit = 0;
+            cursor.Get(hit);
+
+            outHit = FSweepHit();
+            outHit.bHit = hit != 0;
+            if(outHit.bHit)
+            {
+                cursor.GetVec(outHit.Location);
+                cursor.GetVec(outHit.ImpactPoint);
+                cursor.GetVec(outHit.ImpactNormal);
+                cursor.Get(outHit.SurfaceType);
+            }
+        }
+
+        void putFrame(std::vector<uint8_t>& out, const FVehicleFrame& frame)
+        {
+            putVec(out, frame.Location);
+            putQuat(out, frame.Rotation);
+            putVec(out, frame.Scale);
+            putVec(out, frame.Forward);
+            putVec(out, frame.Right);
+            putVec(out, frame.Up);
+            putVec(out, frame.LinearVelocity);
+            putVec(out, frame.AngularVelocity);
+            putVec(out, frame.CenterOfMass);
+            put(out, frame.Mass);
+        }
+
+        void getFrame(FCursor& cursor, FVehicleFrame& outFrame)
+        {
+            cursor.GetVec(outFrame.Location);
+            cursor.GetQuat(outFrame.Rotation);
+            cursor.GetVec(outFrame.Scale);
+            cursor.GetVec(outFrame.Forward);
+            cursor.GetVec(outFrame.Right);
+            cursor.GetVec(outFrame.Up);
+            cursor.GetVec(outFrame.LinearVelocity);
+            cursor.GetVec(outFrame.AngularVelocity);
+            cursor.GetVec(outFrame.CenterOfMass);
+            cursor.Get(outFrame.Mass);
+        }
+
+        bool bitEqual(float a, float b)
+        {
+            return std::memcmp(&a, &b, sizeof(float)) == 0;
+        }
+
+        bool bitEqual(const FVec3& a, const FVec3& b)
+        {
+            return bitEqual(a.X, b.X) && bitEqual(a.Y, b.Y) && bitEqual(a.Z, b.Z);
+        }
+
+        // Bytes of one suspension unit in a vehicle chunk
+        const size_t UnitSize = 1 + sizeof(float) * (3 + 4 + 4);
+
+        bool isFinite(const FVec3& value)
+        {
+            return std::isfinite(value.X) && std::isfinite(value.Y) && std::isfinite(value.Z);
+        }
+
+        bool isFinite(const FQuat4& value)
+        {
+            return std::isfinite(value.X) && std::isfinite(value.Y) && std::isfinite(value.Z) && std::isfinite(value.W);
+        }
+
+        bool areFinite(const std::vector<float>& values)
+        {
+            for(float value : values)
+            {
+                if(!std::isfinite(value))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        bool isGearIndex(int gear, const FGearbox& gearbox)
+        {
+            return gear >= -1 && gear < (int)gearbox.Ratios.size();
+        }
+
+        /// A chunk that decodes is not yet one the simulation may index with, check what it holds
+        bool isValidSetup(const FReplayVehicleSetup& setup)
+        {
+            const FDrivetrainParams& params = setup.Params;
+            if(!std::isfinite(params.MomentInertia) || !std::isfinite(params.SprocketRadiusCm) || !std::isfinite(params.BrakeForce)
+                || !std::isfinite(params.DiferentialRatio) || !std::isfinite(params.TransmissionEfficiency)
+                || !std::isfinite(params.EngineExtraPowerRatio) || !std::isfinite(params.GearRatio)
+                || !std::isfinite(params.SuspTargetVelocity) || !std::isfinite(params.SkidSteer.DeadZone)
+                || !std::isfinite(params.SkidSteer.InnerTrackBrake) || !std::isfinite(params.SkidSteer.CounterSpinAngVel))
+            {
+                return false;
+            }
+
+            const FGearbox& gearbox = setup.Gearbox;
+            const FGearboxSettings& settings = gearbox.Settings;
+            if(gearbox.UpShiftAxleVel.size() != gearbox.Ratios.size() || gearbox.DownShiftAxleVel.size() != gearbox.Ratios.size()
+                || !areFinite(gearbox.Ratios) || !areFinite(gearbox.UpShiftAxleVel) || !areFinite(gearbox.DownShiftAxleVel)
+                || !isGearIndex(gearbox.NeutralGear, gearbox) || !isGearIndex(gearbox.FirstForwardGear, gearbox)
+                || !isGearIndex(gearbox.FirstReverseGear, gearbox)
+                || !std::isfinite(settings.UpShiftPrc) || !std::isfinite(settings.DownShiftPrc) || !std::isfinite(settings.Hysteresis)
+                || !std::isfinite(settings.ShiftDelay) || !std::isfinite(settings.StopAngVel))
+            {
+                return false;
+            }
+
+            // Empty without a curve, otherwise exactly what FCurveTable::Build writes
+            const FCurveTable& torque = setup.EngineTorque;
+            if(!std::isfinite(torque.MinTime) || !std::isfinite(torque.MaxTime) || !std::isfinite(torque.InvStep)
+                || !(torque.MinTime <= torque.MaxTime) || torque.Values.size() == 1 || !areFinite(torque.Values))
+            {
+                return false;
+            }
+            if(torque.IsValid())
+            {
+                const float invStep = torque.MaxTime > torque.MinTime ? (float)(torque.Values.size() - 1) / (torque.MaxTime - torque.MinTime) : 0.0f;
+                if(!bitEqual(torque.InvStep, invStep))
+                {
+                    return false;
+                }
+            }
+
+            for(const FSurfaceParams& surface : setup.Surfaces.Surfaces)
+            {
+                if(!std::isfinite(surface.MuXStatic) || !std::isfinite(surface.MuYStatic) || !std::isfinite(surface.MuXKinetic)
+                    || !std::isfinite(surface.MuYKinetic) || !std::isfinite(surface.RollingFrictionCoef) || !std::isfinite(surface.SinkDepth))
+                {
+                    return false;
+                }
+            }
+
+            if(!std::isfinite(setup.FrictionSprocketRadiusCm) || setup.ReducedStride < 1)
+            {
+                return false;
+            }
+
+            // The store packs left units in front of the right ones
+            bool bRightSide = false;
+            for(const FReplayVehicleSetup::FUnit& unit : setup.Units)
+            {
+                const FSuspensionUnitSetup& unitSetup = unit.Setup;
+                if((bRightSide && unit.Side == ETrackSide::Left) || !isFinite(unitSetup.RootLocation) || !isFinite(unitSetup.RootRotation)
+                    || !std::isfinite(unitSetup.Length) || !std::isfinite(unitSetup.Radius)
+                    || !std::isfinite(unitSetup.Stiffness) || !std::isfinite(unitSetup.Damping))
+                {
+                    return false;
+                }
+                bRightSide = unit.Side == ETrackSide::Right;
+            }
+            return true;
+        }
+    }
+
+    void captureReplayVehicleSetup(const FDrivetrainParams& params, const FGearbox* gearbox, const FCurveTable* engineTorque,
+        const FSurfaceTable& surfaces, float frictionSprocketRadiusCm, int reducedStride, const FSuspensionStore& store, FReplayVehicleSetup& outSetup)
+    {
+        outSetup.Params = params;
+        outSetup.Params.Gearbox = nullptr;
+        outSetup.Params.EngineTorque = nullptr;
+        outSetup.Gearbox = gearbox ? *gearbox : FGearbox();
+        outSetup.EngineTorque = engineTorque ? *engineTorque : FCurveTable();
+        outSetup.Surfaces = surfaces;
+        outSetup.FrictionSprocketRadiusCm = frictionSprocketRadiusCm;
+        outSetup.ReducedStride = reducedStride;
+
+        outSetup.Units.resize(store.Num());
+        for(int unit = 0; unit < store.Num(); unit++)
+        {
+            FReplayVehicleSetup::FUnit& out = outSetup.Units[unit];
+            out.Side = unit < store.LeftCount ? ETrackSide::Left : ETrackSide::Right;
+            out.Setup.RootLocation = store.RootLocation[unit];
+            out.Setup.RootRotation = store.RootRotation[unit];
+            out.Setup.Length = store.Length[unit];
+            out.Setup.Radius = store.Radius[unit];
+            out.Setup.Stiffness = store.Stiffness[unit];
+            out.Setup.Damping = store.Damping[unit];
+        }
+    }
+
+    void applyReplayVehicleSetup(const FReplayVehicleSetup& setup, FVehicleSimulation& outVehicle)
+    {
+        outVehicle.Params = setup.Params;
+        outVehicle.Params.Gearbox = setup.Gearbox.IsValid() ? &setup.Gearbox : nullptr;
+        outVehicle.Params.EngineTorque = setup.EngineTorque.IsValid() ? &setup.EngineTorque : nullptr;
+        outVehicle.Drivetrain = FDrivetrainState();
+        outVehicle.Surfaces = setup.Surfaces;
+        outVehicle.Friction.SprocketRadiusCm = setup.FrictionSprocketRadiusCm;
+
+        // Recorded hits already include reused contacts
+        outVehicle.bReuseContacts = false;
+
+        const int count = (int)setup.Units.size();
+        outVehicle.Suspensions.Reset();
+        outVehicle.Suspensions.Reserve(count);
+        outVehicle.FrictionContacts.Reserve(count);
+        for(const FReplayVehicleSetup::FUnit& unit : setup.Units)
+        {
+            outVehicle.Suspensions.Add(unit.Side, unit.Setup);
+        }
+
+        setSimulationLod(outVehicle, ESimulationLod::Full, setup.ReducedStride);
+    }
+
+    bool FReplayVehicleState::IsBitEqual(const FReplayVehicleState& other) const
+    {
+        return bitEqual(TrackLeftAngVel, other.TrackLeftAngVel)
+            && bitEqual(TrackRightAngVel, other.TrackRightAngVel)
+            && bitEqual(EngineRPM, other.EngineRPM)
+            && bitEqual(Force, other.Force)
+            && bitEqual(Torque, other.Torque);
+    }
+
+    FReplayVehicleState captureReplayVehicleState(const FVehicleSimulation& vehicle)
+    {
+        FReplayVehicleState state;
+        state.TrackLeftAngVel = vehicle.Drivetrain.TrackLeftAngVel;
+        state.TrackRightAngVel = vehicle.Drivetrain.TrackRightAngVel;
+        state.EngineRPM = vehicle.Drivetrain.EngineRPM;
+        state.Force = vehicle.BodyForces.Force;
+        state.Torque = vehicle.BodyForces.Torque;
+        return state;
+    }
+
+    FReplayLogWriter::~FReplayLogWriter()
+    {
+        Close();
+    }
+
+    bool FReplayLogWriter::Open(const char* path)
+    {
+        Close();
+
+        File = std::fopen(path, "wb");
+        if(!File)
+        {
+            return false;
+        }
+
+        bFailed = false;
+        const uint32_t version = Version;
+        bFailed |= std::fwrite(Magic, sizeof(Magic), 1, File) != 1;
+        bFailed |= std::fwrite(&version, sizeof(version), 1, File) != 1;
+        return !bFailed;
+    }
+
+    bool FReplayLogWriter::Close()
+    {
+        if(!File)
+        {
+            return !bFailed;
+        }
+
+        bFailed |= std::fclose(File) != 0;
+        File = nullptr;
+        return !bFailed;
+    }
+
+    void FReplayLogWriter::FlushChunk(uint8_t type)
+    {
+        if(!File)
+        {
+            return;
+        }
+
+        const uint32_t size = (uint32_t)Chunk.size();
+        bFailed |= std::fwrite(&type, 1, 1, File) != 1;
+        bFailed |= std::fwrite(&size, sizeof(size), 1, File) != 1;
+        bFailed |= size > 0 && std::fwrite(Chunk.data(), size, 1, File) != 1;
+    }
+
+    void FReplayLogWriter::WriteVehicle(uint32_t vehicleId, const FReplayVehicleSetup& setup)
+    {
+        Chunk.clear();
+        put(Chunk, vehicleId);
+
+        const FDrivetrainParams& params = setup.Params;
+        put(Chunk, params.MomentInertia);
+        put(Chunk, params.SprocketRadiusCm);
+        put(Chunk, params.BrakeForce);
+        put(Chunk, params.DiferentialRatio);
+        put(Chunk, params.TransmissionEfficiency);
+        put(Chunk, params.EngineExtraPowerRatio);
+        put(Chunk, params.GearRatio);
+        put(Chunk, (uint8_t)(params.bAutoGearBox ? 1 : 0));
+        put(Chunk, params.SuspTargetVelocity);
+        put(Chunk, params.SkidSteer.DeadZone);
+        put(Chunk, params.SkidSteer.InnerTrackBrake);
+        put(Chunk, params.SkidSteer.CounterSpinAngVel);
+
+        const FGearbox& gearbox = setup.Gearbox;
+        putFloats(Chunk, gearbox.Ratios);
+        putFloats(Chunk, gearbox.UpShiftAxleVel);
+        putFloats(Chunk, gearbox.DownShiftAxleVel);
+        put(Chunk, (int32_t)gearbox.NeutralGear);
+        put(Chunk, (int32_t)gearbox.FirstForwardGear);
+        put(Chunk, (int32_t)gearbox.FirstReverseGear);
+        put(Chunk, gearbox.Settings.UpShiftPrc);
+        put(Chunk, gearbox.Settings.DownShiftPrc);
+        put(Chunk, gearbox.Settings.Hysteresis);
+        put(Chunk, gearbox.Settings.ShiftDelay);
+        put(Chunk, gearbox.Settings.StopAngVel);
+
+        put(Chunk, setup.EngineTorque.MinTime);
+        put(Chunk, setup.EngineTorque.MaxTime);
+        put(Chunk, setup.EngineTorque.InvStep);
+        putFloats(Chunk, setup.EngineTorque.Values);
+
+        for(const FSurfaceParams& surface : setup.Surfaces.Surfaces)
+        {
+            put(Chunk, surface.MuXStatic);
+            put(Chunk, surface.MuYStatic);
+            put(Chunk, surface.MuXKinetic);
+            put(Chunk, surface.MuYKinetic);
+            put(Chunk, surface.RollingFrictionCoef);
+            put(Chunk, surface.SinkDepth);
+        }
+        put(Chunk, setup.FrictionSprocketRadiusCm);
+        put(Chunk, (int32_t)setup.ReducedStride);
+
+        put(Chunk, (uint32_t)setup.Units.size());
+        for(const FReplayVehicleSetup::FUnit& unit : setup.Units)
+        {
+            put(Chunk, (uint8_t)unit.Side);
+            putVec(Chunk, unit.Setup.RootLocation);
+            putQuat(Chunk, unit.Setup.RootRotation);
+            put(Chunk, unit.Setup.Length);
+            put(Chunk, unit.Setup.Radius);
+            put(Chunk, unit.Setup.Stiffness);
+            put(Chunk, unit.Setup.Damping);
+        }
+
+        FlushChunk(ChunkVehicle);
+    }
+
+    void FReplayLogWriter::WriteTick(const FReplayVehicleTick& tick)
+    {
+        Chunk.clear();
+        put(Chunk, tick.VehicleId);
+        put(Chunk, tick.DeltaTime);
+        put(Chunk, tick.RawLeftTorque);
+        put(Chunk, tick.RawRightTorque);
+        put(Chunk, (uint8_t)tick.Lod);
+        putFrame(Chunk, tick.Frame);
+
+        put(Chunk, (uint16_t)tick.NumHits);
+        for(int hit = 0; hit < tick.NumHits; hit++)
+        {
+            putHit(Chunk, tick.Hits[hit]);
+        }
+
+        put(Chunk, (uint8_t)(tick.bHasState ? 1 : 0));
+        if(tick.bHasState)
+        {
+            put(Chunk, tick.State.TrackLeftAngVel);
+            put(Chunk, tick.State.TrackRightAngVel);
+            put(Chunk, tick.State.EngineRPM);
+            putVec(Chunk, tick.State.Force);
+            putVec(Chunk, tick.State.Torque);
+        }
+
+        FlushChunk(ChunkTick);
+    }
+
+    FReplayLogFile::~FReplayLogFile()
+    {
+        Close();
+    }
+
+    bool FReplayLogFile::Open(const char* path)
+    {
+        Close();
+
+#if defined(_WIN32)
+        HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if(file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        FileHandle = file;
+
+        LARGE_INTEGER size;
+        if(!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            Close();
+            return false;
+        }
+
+        MappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        Data = MappingHandle ? (const uint8_t*)MapViewOfFile(MappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        Size = (size_t)size.QuadPart;
+#else
+        const int file = ::open(path, O_RDONLY);
+        if(file < 0)
+        {
+            return false;
+        }
+
+        struct stat status;
+        void* mapping = MAP_FAILED;
+        if(::fstat(file, &status) == 0 && status.st_size > 0)
+        {
+            mapping = ::mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        }
+        // The mapping keeps the file alive
+        ::close(file);
+
+        if(mapping != MAP_FAILED)
+        {
+            Data = (const uint8_t*)mapping;
+            Size = (size_t)status.st_size;
+            // Replays walk the log front to back
+            ::madvise(mapping, Size, MADV_SEQUENTIAL);
+        }
+#endif
+
+        uint32_t version = 0;
+        if(Data && Size >= HeaderSize)
+        {
+            std::memcpy(&version, Data + sizeof(Magic), sizeof(version));
+        }
+        if(!Data || Size < HeaderSize || std::memcmp(Data, Magic, sizeof(Magic)) != 0 || version != FReplayLogWriter::Version)
+        {
+            Close();
+            return false;
+        }
+        return true;
+    }
+
+    void FReplayLogFile::Close()
+    {
+#if defined(_WIN32)
+        if(Data)
+        {
+            UnmapViewOfFile(Data);
+        }
+        if(MappingHandle)
+        {
+            CloseHandle(MappingHandle);
+        }
+        if(FileHandle)
+        {
+            CloseHandle(FileHandle);
+        }
+        MappingHandle = nullptr;
+        FileHandle = nullptr;
+#else
+        if(Data)
+        {
+            ::munmap(const_cast<uint8_t*>(Data), Size);
+        }
+#endif
+        Data = nullptr;
+        Size = 0;
+    }
+
+    FReplayLogReader::FReplayLogReader(const FReplayLogFile& file)
+        : Begin(file.GetData() ? file.GetData() + HeaderSize : nullptr)
+        , End(file.GetData() ? file.GetData() + file.GetSize() : nullptr)
+        , Cursor(Begin)
+    {
+    }
+
+    void FReplayLogReader::Rewind()
+    {
+        Cursor = Begin;
+    }
+
+    FReplayLogReader::EChunk FReplayLogReader::Next(uint32_t& outVehicleId, FReplayVehicleSetup& outSetup, FReplayVehicleTick& outTick)
+    {
+        while(Cursor && Cursor < End)
+        {
+            if((size_t)(End - Cursor) < ChunkHeaderSize)
+            {
+                return EChunk::Corrupt;
+            }
+
+            const uint8_t type = Cursor[0];
+            uint32_t size = 0;
+            std::memcpy(&size, Cursor + 1, sizeof(size));
+            if((size_t)(End - Cursor) - ChunkHeaderSize < size)
+            {
+                return EChunk::Corrupt;
+            }
+
+            FCursor cursor{ Cursor + ChunkHeaderSize, Cursor + ChunkHeaderSize + size };
+            Cursor = cursor.End;
+
+            if(type == ChunkVehicle)
+            {
+                cursor.Get(outVehicleId);
+
+                FDrivetrainParams& params = outSetup.Params;
+                uint8_t autoGearBox = 0;
+                cursor.Get(params.MomentInertia);
+                cursor.Get(params.SprocketRadiusCm);
+                cursor.Get(params.BrakeForce);
+                cursor.Get(params.DiferentialRatio);
+                cursor.Get(params.TransmissionEfficiency);
+                cursor.Get(params.EngineExtraPowerRatio);
+                cursor.Get(params.GearRatio);
+                cursor.Get(autoGearBox);
+                cursor.Get(params.SuspTargetVelocity);
+                cursor.Get(params.SkidSteer.DeadZone);
+                cursor.Get(params.SkidSteer.InnerTrackBrake);
+                cursor.Get(params.SkidSteer.CounterSpinAngVel);
+                params.bAutoGearBox = autoGearBox != 0;
+                params.Gearbox = nullptr;
+                params.EngineTorque = nullptr;
+
+                FGearbox& gearbox = outSetup.Gearbox;
+                int32_t neutralGear = -1;
+                int32_t firstForwardGear = -1;
+                int32_t firstReverseGear = -1;
+                cursor.GetFloats(gearbox.Ratios);
+                cursor.GetFloats(gearbox.UpShiftAxleVel);
+                cursor.GetFloats(gearbox.DownShiftAxleVel);
+                cursor.Get(neutralGear);
+                cursor.Get(firstForwardGear);
+                cursor.Get(firstReverseGear);
+                cursor.Get(gearbox.Settings.UpShiftPrc);
+                cursor.Get(gearbox.Settings.DownShiftPrc);
+                cursor.Get(gearbox.Settings.Hysteresis);
+                cursor.Get(gearbox.Settings.ShiftDelay);
+                cursor.Get(gearbox.Settings.StopAngVel);
+                gearbox.NeutralGear = neutralGear;
+                gearbox.FirstForwardGear = firstForwardGear;
+                gearbox.FirstReverseGear = firstReverseGear;
+
+                cursor.Get(outSetup.EngineTorque.MinTime);
+                cursor.Get(outSetup.EngineTorque.MaxTime);
+                cursor.Get(outSetup.EngineTorque.InvStep);
+                cursor.GetFloats(outSetup.EngineTorque.Values);
+
+                for(FSurfaceParams& surface : outSetup.Surfaces.Surfaces)
+                {
+                    cursor.Get(surface.MuXStatic);
+                    cursor.Get(surface.MuYStatic);
+                    cursor.Get(surface.MuXKinetic);
+                    cursor.Get(surface.MuYKinetic);
+                    cursor.Get(surface.RollingFrictionCoef);
+                    cursor.Get(surface.SinkDepth);
+                }
+                int32_t reducedStride = 2;
+                cursor.Get(outSetup.FrictionSprocketRadiusCm);
+                cursor.Get(reducedStride);
+                outSetup.ReducedStride = reducedStride;
+
+                uint32_t numUnits = 0;
+                cursor.Get(numUnits);
+                // A corrupt count must not size the units past what the chunk holds
+                if(cursor.bOk && (size_t)(cursor.End - cursor.Data) / UnitSize < numUnits)
+                {
+                    return EChunk::Corrupt;
+                }
+                outSetup.Units.resize(cursor.bOk ? numUnits : 0);
+                for(FReplayVehicleSetup::FUnit& unit : outSetup.Units)
+                {
+                    uint8_t side = 0;
+                    cursor.Get(side);
+                    cursor.GetVec(unit.Setup.RootLocation);
+                    cursor.GetQuat(unit.Setup.RootRotation);
+                    cursor.Get(unit.Setup.Length);
+                    cursor.Get(unit.Setup.Radius);
+                    cursor.Get(unit.Setup.Stiffness);
+                    cursor.Get(unit.Setup.Damping);
+                    unit.Side = side == (uint8_t)ETrackSide::Right ? ETrackSide::Right : ETrackSide::Left;
+                }
+
+                return cursor.bOk && isValidSetup(outSetup) ? EChunk::Vehicle : EChunk::Corrupt;
+            }
+
+            if(type == ChunkTick)
+            {
+                uint8_t lod = 0;
+                uint16_t numHits = 0;
+                uint8_t hasState = 0;
+
+                cursor.Get(outTick.VehicleId);
+                cursor.Get(outTick.DeltaTime);
+                cursor.Get(outTick.RawLeftTorque);
+                cursor.Get(outTick.RawRightTorque);
+                cursor.Get(lod);
+                getFrame(cursor, outTick.Frame);
+                outTick.Lod = lod <= (uint8_t)ESimulationLod::Kinematic ? (ESimulationLod)lod : ESimulationLod::Full;
+
+                cursor.Get(numHits);
+                Hits.resize(cursor.bOk ? numHits : 0);
+                for(FSweepHit& hit : Hits)
+                {
+                    getHit(cursor, hit);
+                }
+                outTick.Hits = Hits.data();
+                outTick.NumHits = (int)Hits.size();
+
+                cursor.Get(hasState);
+                outTick.bHasState = hasState != 0;
+                if(outTick.bHasState)
+                {
+                    cursor.Get(outTick.State.TrackLeftAngVel);
+                    cursor.Get(outTick.State.TrackRightAngVel);
+                    cursor.Get(outTick.State.EngineRPM);
+                    cursor.GetVec(outTick.State.Force);
+                    cursor.GetVec(outTick.State.Torque);
+                }
+
+                return cursor.bOk ? EChunk::Tick : EChunk::Corrupt;
+            }
+        }
+
+        return EChunk::End;
+    }
+
+    void FReplayGroundQuery::SweepBatch(const FSweepRequest* /*requests*/, FSweepHit* hits, int count)
+    {
+        for(int index = 0; index < count; index++)
+        {
+            if(index < NumHits)
+            {
+                hits[index] = Hits[index];
+            }
+            else
+            {
+                hits[index] = FSweepHit();
+                NumMissing++;
+            }
+        }
+    }
+
+    bool replayVehicleTick(FVehicleSimulation& vehicle, int reducedStride, const FReplayVehicleTick& tick, FReplayGroundQuery& ground)
+    {
+        if(vehicle.Lod != tick.Lod)
+        {
+            setSimulationLod(vehicle, tick.Lod, reducedStride);
+        }
+
+        vehicle.Frame = tick.Frame;
+        vehicle.Drivetrain.RawLeftTorque = tick.RawLeftTorque;
+        vehicle.Drivetrain.RawRightTorque = tick.RawRightTorque;
+
+        ground.SetHits(tick.Hits, tick.NumHits);
+        simulateVehicleTick(vehicle, ground, tick.DeltaTime);
+
+        return !tick.bHasState || captureReplayVehicleState(vehicle).IsBitEqual(tick.State);
+    }
+}
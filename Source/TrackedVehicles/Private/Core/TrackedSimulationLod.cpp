@@ -0,0 +1,164 @@
+#include "Core/TrackedSimulationLod.h"
+
+namespace TrackedCore
+{
+    void selectTracedUnits(const FSuspensionStore& store, ESimulationLod lod, int reducedStride, std::vector<int>& outUnits)
+    {
+        outUnits.clear();
+
+        const int stride = lod == ESimulationLod::Reduced ? (reducedStride > 1 ? reducedStride : 1) : 1;
+        const ETrackSide sides[] = { ETrackSide::Left, ETrackSide::Right };
+
+        for(ETrackSide side : sides)
+        {
+            const int begin = store.SideBegin(side);
+            const int end = store.SideEnd(side);
+            if(begin == end)
+            {
+                continue;
+            }
+
+            if(lod == ESimulationLod::Kinematic)
+            {
+                outUnits.push_back(begin);
+                if(end - 1 != begin)
+                {
+                    outUnits.push_back(end - 1);
+                }
+                continue;
+            }
+
+            for(int index = begin; index < end; index += stride)
+            {
+                outUnits.push_back(index);
+            }
+            if(outUnits.back() != end - 1)
+            {
+                outUnits.push_back(end - 1);
+            }
+        }
+    }
+
+    namespace
+    {
+        void copyContact(FSuspensionStore& store, int target, int source, float newLength)
+        {
+            store.NewLength[target] = newLength;
+            store.Engaged[target] = store.Engaged[source];
+            store.HitMaterial[target] = store.HitMaterial[source];
+            store.ContactNormal[target] = store.ContactNormal[source];
+            store.ContactPoint[target] = store.Engaged[source]
+                ? store.WorldLocation[target] - store.WorldUp[target] * newLength - store.ContactNormal[source] * store.Radius[target]
+                : FVec3();
+        }
+    }
+
+    void interpolateSkippedUnits(FSuspensionStore& store, const std::vector<int>& tracedUnits)
+    {
+        // Traced units of a side are sorted, walk the gaps between neighbours
+        for(size_t traced = 0; traced + 1 < tracedUnits.size(); traced++)
+        {
+            const int from = tracedUnits[traced];
+            const int to = tracedUnits[traced + 1];
+            if(to - from < 2 || store.SideOf(from) != store.SideOf(to))
+            {
+                continue;
+            }
+
+            for(int index = from + 1; index < to; index++)
+            {
+                const float alpha = (float)(index - from) / (float)(to - from);
+                const float ratioFrom = store.NewLength[from] / store.Length[from];
+                const float ratioTo = store.NewLength[to] / store.Length[to];
+                const float newLength = store.Length[index] * (ratioFrom + (ratioTo - ratioFrom) * alpha);
+
+                // Engaged only between two engaged units, a gap over a ditch stays in the air
+                const int source = alpha < 0.5f ? from : to;
+                const bool engaged = store.Engaged[from] && store.Engaged[to];
+                copyContact(store, index, source, engaged ? newLength : store.Length[index]);
+                store.Engaged[index] = engaged ? 1 : 0;
+                if(!engaged)
+                {
+                    store.ContactPoint[index] = FVec3();
+                    store.ContactNormal[index] = FVec3();
+                }
+            }
+        }
+    }
+
+    FGroundFollow fitGroundFollow(const FSuspensionStore& store, float rideRatio)
+    {
+        // error = a + b * x + c * y over root locations in hull space
+        double sum1 = 0.0, sumX = 0.0, sumY = 0.0, sumXX = 0.0, sumXY = 0.0, sumYY = 0.0;
+        double sumE = 0.0, sumXE = 0.0, sumYE = 0.0;
+
+        for(int index = 0; index < store.Num(); index++)
+        {
+            if(!store.Engaged[index])
+            {
+                continue;
+            }
+
+            const double x = store.RootLocation[index].X;
+            const double y = store.RootLocation[index].Y;
+            const double error = store.NewLength[index] - store.Length[index] * rideRatio;
+
+            sum1 += 1.0; sumX += x; sumY += y;
+            sumXX += x * x; sumXY += x * y; sumYY += y * y;
+            sumE += error; sumXE += x * error; sumYE += y * error;
+        }
+
+        FGroundFollow result;
+        if(sum1 < 1.0)
+        {
+            return result;
+        }
+
+        result.bValid = true;
+
+        // Normal equations solved by Cramer's rule, a degenerated layout falls back to height only
+        const double det = sum1 * (sumXX * sumYY - sumXY * sumXY)
+                         - sumX * (sumX * sumYY - sumXY * sumY)
+                         + sumY * (sumX * sumXY - sumXX * sumY);
+        if(std::fabs(det) < 1.e-6 * (sumXX * sumYY + 1.0))
+        {
+            result.HeightOffset = (float)(-sumE / sum1);
+            return result;
+        }
+
+        const double a = (sumE * (sumXX * sumYY - sumXY * sumXY)
+                        - sumX * (sumXE * sumYY - sumXY * sumYE)
+                        + sumY * (sumXE * sumXY - sumXX * sumYE)) / det;
+        const double b = (sum1 * (sumXE * sumYY - sumXY * sumYE)
+                        - sumE * (sumX * sumYY - sumXY * sumY)
+                        + sumY * (sumX * sumYE - sumXE * sumY)) / det;
+        const double c = (sum1 * (sumXX * sumYE - sumXE * sumXY)
+                        - sumX * (sumX * sumYE - sumXE * sumY)
+                        + sumE * (sumX * sumXY - sumXX * sumY)) / det;
+
+        // Longer suspension means the ground sits lower than the ride height
+        result.HeightOffset = (float)-a;
+        result.PitchAngle = (float)-std::atan(b);
+        result.RollAngle = (float)-std::atan(c);
+        return result;
+    }
+
+    float calculateTrackWidth(const FSuspensionStore& store)
+    {
+        float leftY = 0.0f;
+        float rightY = 0.0f;
+        const int leftCount = store.SideEnd(ETrackSide::Left) - store.SideBegin(ETrackSide::Left);
+        const int rightCount = store.SideEnd(ETrackSide::Right) - store.SideBegin(ETrackSide::Right);
+
+        for(int index = 0; index < store.Num(); index++)
+        {
+            (store.SideOf(index) == ETrackSide::Left ? leftY : rightY) += store.RootLocation[index].Y;
+        }
+
+        if(leftCount == 0 || rightCount == 0)
+        {
+            return 0.0f;
+        }
+        return std::fabs(rightY / rightCount - leftY / leftCount);
+    }
+}
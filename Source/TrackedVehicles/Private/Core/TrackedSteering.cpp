@@ -0,0 +1,69 @@
+#include "Core/TrackedSteering.h"
+
+namespace TrackedCore
+{
+    namespace
+    {
+        float applyDeadZone(float input, float deadZone)
+        {
+            input = fclamp(input, -1.0f, 1.0f);
+            return std::fabs(input) < deadZone ? 0.0f : input;
+        }
+
+        float counterSpinBrake(float input, float trackAngVel, const FSkidSteerSettings& settings)
+        {
+            if(input * trackAngVel < 0.0f && std::fabs(trackAngVel) > settings.CounterSpinAngVel)
+            {
+                return std::fabs(input);
+            }
+            return 0.0f;
+        }
+    }
+
+    FSkidSteerCommand mapSkidSteerInput(float leftInput, float rightInput, float trackLeftAngVel, float trackRightAngVel, const FSkidSteerSettings& settings)
+    {
+        FSkidSteerCommand command;
+
+        const float left = applyDeadZone(leftInput, settings.DeadZone);
+        const float right = applyDeadZone(rightInput, settings.DeadZone);
+
+        if(left == 0.0f && right == 0.0f)
+        {
+            command.BrakeRatioLeft = 1.0f;
+            command.BrakeRatioRight = 1.0f;
+            return command;
+        }
+
+        // calculateTorqueTransfer adds them back up to left and right
+        command.WheelForwardCoefficient = (left + right) * 0.5f;
+        command.WheelLeftCoefficient = left - command.WheelForwardCoefficient;
+        command.WheelRightCoefficient = right - command.WheelForwardCoefficient;
+
+        if(left == 0.0f)
+        {
+            command.BrakeRatioLeft = 1.0f;
+        }
+        else if(right == 0.0f)
+        {
+            command.BrakeRatioRight = 1.0f;
+        }
+        else if(left * right > 0.0f)
+        {
+            const float leftAbs = std::fabs(left);
+            const float rightAbs = std::fabs(right);
+            if(leftAbs < rightAbs)
+            {
+                command.BrakeRatioLeft = settings.InnerTrackBrake * (1.0f - leftAbs / rightAbs);
+            }
+            else if(rightAbs < leftAbs)
+            {
+                command.BrakeRatioRight = settings.InnerTrackBrake * (1.0f - rightAbs / leftAbs);
+            }
+        }
+
+        command.BrakeRatioLeft = std::fmax(command.BrakeRatioLeft, counterSpinBrake(left, trackLeftAngVel, settings));
+        command.BrakeRatioRight = std::fmax(command.BrakeRatioRight, counterSpinBrake(right, trackRightAngVel, settings));
+
+        return command;
+    }
+}
@@ -0,0 +1,24 @@
+#include "Core/TrackedSuspension.h"
+
+namespace TrackedCore
+{
+    float calculateSuspensionForceMagnitude(
+        float length,
+        float newLength,
+        float previousLength,
+        float stiffness,
+        float damping,
+        float targetVelocity,
+        float dt)
+    {
+        // rate and stiffness
+        float compressionRate = fclamp((length - newLength) / length, 0.0f, 1.0f);
+        float compressionStiffness = compressionRate * stiffness;
+
+        // calculate susp velocity
+        float suspensionVelocity = (newLength - previousLength) / dt;
+        suspensionVelocity = damping * (targetVelocity - suspensionVelocity);
+
+        return compressionRate * compressionStiffness + suspensionVelocity;
+    }
+}
@@ -0,0 +1,109 @@
+#include "Core/TrackedSuspensionKernel.h"
+#include "Core/TrackedSuspension.h"
+
+#if defined(TRACKEDCORE_SIMD_AVX2)
+    #include <immintrin.h>
+#elif defined(TRACKEDCORE_SIMD_SSE2)
+    #include <emmintrin.h>
+#endif
+
+namespace TrackedCore
+{
+    void calculateSuspensionForceMagnitudesScalar(
+        const float* length,
+        const float* newLength,
+        const float* previousLength,
+        const float* stiffness,
+        const float* damping,
+        float targetVelocity,
+        float dt,
+        float* outForceMagnitude,
+        int count)
+    {
+        for(int index = 0; index < count; index++)
+        {
+            outForceMagnitude[index] = calculateSuspensionForceMagnitude(
+                length[index],
+                newLength[index],
+                previousLength[index],
+                stiffness[index],
+                damping[index],
+                targetVelocity,
+                dt);
+        }
+    }
+
+    void calculateSuspensionForceMagnitudes(
+        const float* length,
+        const float* newLength,
+        const float* previousLength,
+        const float* stiffness,
+        const float* damping,
+        float targetVelocity,
+        float dt,
+        float* outForceMagnitude,
+        int count)
+    {
+        int index = 0;
+
+#if defined(TRACKEDCORE_SIMD_AVX2)
+        const __m256 zero = _mm256_setzero_ps();
+        const __m256 one = _mm256_set1_ps(1.0f);
+        const __m256 target = _mm256_set1_ps(targetVelocity);
+        const __m256 deltaTime = _mm256_set1_ps(dt);
+
+        for(; index + 8 <= count; index += 8)
+        {
+            __m256 restLength = _mm256_loadu_ps(length + index);
+            __m256 currentLength = _mm256_loadu_ps(newLength + index);
+
+            // rate and stiffness
+            __m256 compressionRate = _mm256_div_ps(_mm256_sub_ps(restLength, currentLength), restLength);
+            // max/min return their second operand on NaN, keep the rate there so NaN passes like fclamp
+            compressionRate = _mm256_min_ps(one, _mm256_max_ps(zero, compressionRate));
+            __m256 compressionStiffness = _mm256_mul_ps(compressionRate, _mm256_loadu_ps(stiffness + index));
+
+            // damper against target velocity
+            __m256 velocity = _mm256_div_ps(_mm256_sub_ps(currentLength, _mm256_loadu_ps(previousLength + index)), deltaTime);
+            velocity = _mm256_mul_ps(_mm256_loadu_ps(damping + index), _mm256_sub_ps(target, velocity));
+
+            _mm256_storeu_ps(outForceMagnitude + index, _mm256_add_ps(_mm256_mul_ps(compressionRate, compressionStiffness), velocity));
+        }
+#elif defined(TRACKEDCORE_SIMD_SSE2)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one = _mm_set1_ps(1.0f);
+        const __m128 target = _mm_set1_ps(targetVelocity);
+        const __m128 deltaTime = _mm_set1_ps(dt);
+
+        for(; index + 4 <= count; index += 4)
+        {
+            __m128 restLength = _mm_loadu_ps(length + index);
+            __m128 currentLength = _mm_loadu_ps(newLength + index);
+
+            // rate and stiffness
+            __m128 compressionRate = _mm_div_ps(_mm_sub_ps(restLength, currentLength), restLength);
+            // max/min return their second operand on NaN, keep the rate there so NaN passes like fclamp
+            compressionRate = _mm_min_ps(one, _mm_max_ps(zero, compressionRate));
+            __m128 compressionStiffness = _mm_mul_ps(compressionRate, _mm_loadu_ps(stiffness + index));
+
+            // damper against target velocity
+            __m128 velocity = _mm_div_ps(_mm_sub_ps(currentLength, _mm_loadu_ps(previousLength + index)), deltaTime);
+            velocity = _mm_mul_ps(_mm_loadu_ps(damping + index), _mm_sub_ps(target, velocity));
+
+            _mm_storeu_ps(outForceMagnitude + index, _mm_add_ps(_mm_mul_ps(compressionRate, compressionStiffness), velocity));
+        }
+#endif
+
+        // Remainder (or whole range without SIMD)
+        calculateSuspensionForceMagnitudesScalar(
+            length + index,
+            newLength + index,
+            previousLength + index,
+            stiffness + index,
+            damping + index,
+            targetVelocity,
+            dt,
+            outForceMagnitude + index,
+            count - index);
+    }
+}
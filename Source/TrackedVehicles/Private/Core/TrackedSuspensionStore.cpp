@@ -0,0 +1,100 @@
+#include "Core/TrackedSuspensionStore.h"
+#include <algorithm>
+#include <cassert>
+
+namespace TrackedCore
+{
+    void FSuspensionStore::Reserve(int count)
+    {
+        RootLocation.reserve(count);
+        RootRotation.reserve(count);
+        LocalUp.reserve(count);
+        LocalForward.reserve(count);
+        LocalRight.reserve(count);
+        Length.reserve(count);
+        Radius.reserve(count);
+        Stiffness.reserve(count);
+        Damping.reserve(count);
+        PreviousLength.reserve(count);
+        NewLength.reserve(count);
+        ForceMagnitude.reserve(count);
+        WorldLocation.reserve(count);
+        WorldUp.reserve(count);
+        Force.reserve(count);
+        ContactPoint.reserve(count);
+        ContactNormal.reserve(count);
+        Engaged.reserve(count);
+        HitMaterial.reserve(count);
+    }
+
+    void FSuspensionStore::Reset()
+    {
+        LeftCount = 0;
+        RootLocation.clear();
+        RootRotation.clear();
+        LocalUp.clear();
+        LocalForward.clear();
+        LocalRight.clear();
+        Length.clear();
+        Radius.clear();
+        Stiffness.clear();
+        Damping.clear();
+        PreviousLength.clear();
+        NewLength.clear();
+        ForceMagnitude.clear();
+        WorldLocation.clear();
+        WorldUp.clear();
+        Force.clear();
+        ContactPoint.clear();
+        ContactNormal.clear();
+        Engaged.clear();
+        HitMaterial.clear();
+    }
+
+    void FSuspensionStore::ResetState()
+    {
+        PreviousLength = Length;
+        NewLength = Length;
+        std::fill(ForceMagnitude.begin(), ForceMagnitude.end(), 0.0f);
+        std::fill(WorldLocation.begin(), WorldLocation.end(), FVec3());
+        std::fill(WorldUp.begin(), WorldUp.end(), FVec3());
+        std::fill(Force.begin(), Force.end(), FVec3());
+        std::fill(ContactPoint.begin(), ContactPoint.end(), FVec3());
+        std::fill(ContactNormal.begin(), ContactNormal.end(), FVec3());
+        std::fill(Engaged.begin(), Engaged.end(), (uint8_t)0);
+        std::fill(HitMaterial.begin(), HitMaterial.end(), (uint8_t)0);
+    }
+
+    int FSuspensionStore::Add(ETrackSide side, const FSuspensionUnitSetup& setup)
+    {
+        // Left units are packed in front of the right ones
+        assert(side == ETrackSide::Right || LeftCount == Num());
+
+        RootLocation.push_back(setup.RootLocation);
+        RootRotation.push_back(setup.RootRotation);
+        LocalUp.push_back(rotateVector(setup.RootRotation, FVec3(0.0f, 0.0f, 1.0f)));
+        LocalForward.push_back(rotateVector(setup.RootRotation, FVec3(1.0f, 0.0f, 0.0f)));
+        LocalRight.push_back(rotateVector(setup.RootRotation, FVec3(0.0f, 1.0f, 0.0f)));
+        Length.push_back(setup.Length);
+        Radius.push_back(setup.Radius);
+        Stiffness.push_back(setup.Stiffness);
+        Damping.push_back(setup.Damping);
+        PreviousLength.push_back(setup.Length);
+        NewLength.push_back(setup.Length);
+        ForceMagnitude.push_back(0.0f);
+        WorldLocation.push_back(FVec3());
+        WorldUp.push_back(FVec3());
+        Force.push_back(FVec3());
+        ContactPoint.push_back(FVec3());
+        ContactNormal.push_back(FVec3());
+        Engaged.push_back(0);
+        HitMaterial.push_back(0);
+
+        if(side == ETrackSide::Left)
+        {
+            LeftCount++;
+        }
+
+        return Num() - 1;
+    }
+}
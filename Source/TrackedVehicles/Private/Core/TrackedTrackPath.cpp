@@ -0,0 +1,352 @@
+#include "Core/TrackedTrackPath.h"
+#include <algorithm>
+#include <cassert>
+
+namespace TrackedCore
+{
+    namespace
+    {
+        // Dense steps per segment used to measure arc length before resampling
+        const int ArcLengthOversampling = 4;
+        // Control points this far from a wheel center, in wheel radii, ride on the wheel
+        const float TrackBindRadiusScale = 1.5f;
+
+        void evaluateHermite(const FVec3& p0, const FVec3& m0, const FVec3& p1, const FVec3& m1, float t, FVec3& outLocation, FVec3& outDerivative)
+        {
+            const float t2 = t * t;
+            const float t3 = t2 * t;
+
+            outLocation = p0 * (2.0f * t3 - 3.0f * t2 + 1.0f)
+                + m0 * (t3 - 2.0f * t2 + t)
+                + p1 * (-2.0f * t3 + 3.0f * t2)
+                + m1 * (t3 - t2);
+
+            outDerivative = p0 * (6.0f * t2 - 6.0f * t)
+                + m0 * (3.0f * t2 - 4.0f * t + 1.0f)
+                + p1 * (-6.0f * t2 + 6.0f * t)
+                + m1 * (3.0f * t2 - 2.0f * t);
+        }
+
+        float wrapDistance(float distance, float length)
+        {
+            distance = std::fmod(distance, length);
+            return distance < 0.0f ? distance + length : distance;
+        }
+    }
+
+    void FTrackPath::Build(const FVec3* points, const FVec3* tangents, int numPoints, int samplesPerSegment)
+    {
+        SamplesPerSegment = samplesPerSegment > 1 ? samplesPerSegment : 1;
+
+        Points.assign(points, points + numPoints);
+        Tangents.resize(numPoints);
+        for(int index = 0; index < numPoints; index++)
+        {
+            Tangents[index] = tangents
+                ? tangents[index]
+                : (points[(index + 1) % numPoints] - points[(index + numPoints - 1) % numPoints]) * 0.5f;
+        }
+
+        // Shoelace area in XZ, negative when the loop runs forward along its top
+        float area = 0.0f;
+        for(int index = 0; index < numPoints; index++)
+        {
+            const FVec3& a = points[index];
+            const FVec3& b = points[(index + 1) % numPoints];
+            area += a.X * b.Z - b.X * a.Z;
+        }
+        Winding = area <= 0.0f ? 1.0f : -1.0f;
+
+        const int numSamples = numPoints * (SamplesPerSegment + 1);
+        SegmentLength.assign(numPoints, 0.0f);
+        Location.resize(numSamples);
+        Direction.resize(numSamples);
+
+        if(numPoints < 2)
+        {
+            SegmentStart.clear();
+            return;
+        }
+
+        SegmentStart.resize(numPoints + 1);
+        float start = 0.0f;
+        for(int segment = 0; segment < numPoints; segment++)
+        {
+            SolveSegment(segment);
+            SegmentStart[segment] = start;
+            start += SegmentLength[segment];
+        }
+        SegmentStart[numPoints] = start;
+    }
+
+    void FTrackPath::SolveSegment(int segment)
+    {
+        const int numPoints = NumSegments();
+        const FVec3& p0 = Points[segment];
+        const FVec3& m0 = Tangents[segment];
+        const FVec3& p1 = Points[(segment + 1) % numPoints];
+        const FVec3& m1 = Tangents[(segment + 1) % numPoints];
+
+        // Measure the curve densely, then walk it again picking uniform arc length samples
+        const int numSteps = SamplesPerSegment * ArcLengthOversampling;
+        const float stepT = 1.0f / (float)numSteps;
+
+        FVec3 location;
+        FVec3 derivative;
+        FVec3 previous = p0;
+        float length = 0.0f;
+        for(int step = 1; step <= numSteps; step++)
+        {
+            evaluateHermite(p0, m0, p1, m1, (float)step * stepT, location, derivative);
+            length += distance(previous, location);
+            previous = location;
+        }
+        SegmentLength[segment] = length;
+
+        FVec3* outLocation = &Location[segment * (SamplesPerSegment + 1)];
+        FVec3* outDirection = &Direction[segment * (SamplesPerSegment + 1)];
+
+        evaluateHermite(p0, m0, p1, m1, 0.0f, outLocation[0], derivative);
+        outDirection[0] = safeNormal(derivative);
+
+        const float sampleSpacing = length / (float)SamplesPerSegment;
+        int sample = 1;
+        float walked = 0.0f;
+        previous = p0;
+        for(int step = 1; step <= numSteps && sample < SamplesPerSegment; step++)
+        {
+            evaluateHermite(p0, m0, p1, m1, (float)step * stepT, location, derivative);
+            const float stepLength = distance(previous, location);
+
+            while(sample < SamplesPerSegment && walked + stepLength >= sampleSpacing * (float)sample)
+            {
+                const float alpha = stepLength > Epsilon ? (sampleSpacing * (float)sample - walked) / stepLength : 1.0f;
+                evaluateHermite(p0, m0, p1, m1, ((float)(step - 1) + alpha) * stepT, outLocation[sample], derivative);
+                outDirection[sample] = safeNormal(derivative);
+                sample++;
+            }
+
+            walked += stepLength;
+            previous = location;
+        }
+
+        evaluateHermite(p0, m0, p1, m1, 1.0f, outLocation[SamplesPerSegment], derivative);
+        outDirection[SamplesPerSegment] = safeNormal(derivative);
+    }
+
+    void FTrackPath::SampleSegment(int segment, float localDistance, FVec3& outLocation, FVec3& outDirection) const
+    {
+        // Samples are uniform in the current length, the distance is measured at rest
+        const float restLength = SegmentStart[segment + 1] - SegmentStart[segment];
+        const float position = restLength > Epsilon ? fclamp(localDistance / restLength, 0.0f, 1.0f) * (float)SamplesPerSegment : 0.0f;
+
+        int index = (int)position;
+        if(index >= SamplesPerSegment)
+        {
+            index = SamplesPerSegment - 1;
+        }
+        const float alpha = position - (float)index;
+
+        const int base = segment * (SamplesPerSegment + 1) + index;
+        outLocation = Location[base] + (Location[base + 1] - Location[base]) * alpha;
+        outDirection = safeNormal(Direction[base] + (Direction[base + 1] - Direction[base]) * alpha);
+    }
+
+    void FTrackPath::Sample(float distance, FVec3& outLocation, FVec3& outDirection) const
+    {
+        assert(IsValid());
+
+        const float wrapped = wrapDistance(distance, GetLength());
+        const int segment = (int)(std::upper_bound(SegmentStart.begin(), SegmentStart.end() - 1, wrapped) - SegmentStart.begin()) - 1;
+        SampleSegment(segment, wrapped - SegmentStart[segment], outLocation, outDirection);
+    }
+
+    bool FTrackPathBinding::IsBound() const
+    {
+        for(int unit : Unit)
+        {
+            if(unit >= 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void bindTrackPath(const FTrackPath& path, const FSuspensionStore& store, ETrackSide side, float authoredLengthRatio, FTrackPathBinding& outBinding)
+    {
+        const int numPoints = path.NumSegments();
+        outBinding.RestPoints = path.Points;
+        outBinding.Unit.assign(numPoints, -1);
+        outBinding.AuthoredLength.assign(numPoints, 0.0f);
+        outBinding.AppliedLength.assign(numPoints, 0.0f);
+        outBinding.DirtySegments.assign(numPoints, 0);
+
+        for(int point = 0; point < numPoints; point++)
+        {
+            const FVec3& location = path.Points[point];
+            float closest = 0.0f;
+
+            for(int unit = store.SideBegin(side); unit < store.SideEnd(side); unit++)
+            {
+                const float authoredLength = store.Length[unit] * authoredLengthRatio;
+                const FVec3 wheel = store.RootLocation[unit] - store.LocalUp[unit] * authoredLength;
+
+                // Track side plane, Y only tells the sides apart
+                const float dx = location.X - wheel.X;
+                const float dz = location.Z - wheel.Z;
+                const float rimDistance = std::sqrt(dx * dx + dz * dz);
+
+                if(dz > 0.0f || rimDistance > store.Radius[unit] * TrackBindRadiusScale)
+                {
+                    continue;
+                }
+                if(outBinding.Unit[point] < 0 || rimDistance < closest)
+                {
+                    closest = rimDistance;
+                    outBinding.Unit[point] = unit;
+                    outBinding.AuthoredLength[point] = authoredLength;
+                    outBinding.AppliedLength[point] = authoredLength;
+                }
+            }
+        }
+    }
+
+    FTrackLoopRange updateTrackPath(FTrackPath& path, FTrackPathBinding& binding, const FSuspensionStore& store, float epsilon)
+    {
+        const int numSegments = path.NumSegments();
+        bool anyMoved = false;
+
+        for(int point = 0; point < numSegments; point++)
+        {
+            const int unit = binding.Unit[point];
+            if(unit < 0)
+            {
+                continue;
+            }
+
+            const float length = store.PreviousLength[unit];
+            if(std::fabs(length - binding.AppliedLength[point]) <= epsilon)
+            {
+                continue;
+            }
+
+            // Shorter suspension lifts the wheel, and the track under it, along the unit up axis
+            path.Points[point] = binding.RestPoints[point] + store.LocalUp[unit] * (binding.AuthoredLength[point] - length);
+            binding.AppliedLength[point] = length;
+
+            binding.DirtySegments[point] = 1;
+            binding.DirtySegments[(point + numSegments - 1) % numSegments] = 1;
+            anyMoved = true;
+        }
+
+        if(!anyMoved)
+        {
+            return FTrackLoopRange();
+        }
+
+        // Solve the dirty segments and cover them with one range, leaving out the longest clean run
+        int longestClean = 0;
+        int longestCleanEnd = 0;
+        int clean = 0;
+        for(int step = 0; step < numSegments * 2; step++)
+        {
+            const int segment = step % numSegments;
+            if(binding.DirtySegments[segment])
+            {
+                clean = 0;
+                continue;
+            }
+
+            clean++;
+            if(clean > longestClean && clean <= numSegments)
+            {
+                longestClean = clean;
+                longestCleanEnd = segment + 1;
+            }
+        }
+
+        for(int segment = 0; segment < numSegments; segment++)
+        {
+            if(binding.DirtySegments[segment])
+            {
+                path.SolveSegment(segment);
+                binding.DirtySegments[segment] = 0;
+            }
+        }
+
+        return FTrackLoopRange(longestCleanEnd % numSegments, numSegments - longestClean);
+    }
+
+    FTrackLoopRange linksOnSegments(const FTrackPath& path, float phase, int numLinks, const FTrackLoopRange& segments)
+    {
+        if(segments.IsEmpty())
+        {
+            return FTrackLoopRange();
+        }
+
+        const int numSegments = path.NumSegments();
+        if(segments.Count >= numSegments)
+        {
+            return FTrackLoopRange(0, numLinks);
+        }
+
+        const float length = path.GetLength();
+        const float spacing = length / (float)numLinks;
+
+        const int last = segments.First + segments.Count;
+        const float begin = path.SegmentStart[segments.First];
+        const float end = last <= numSegments
+            ? path.SegmentStart[last]
+            : path.SegmentStart[last - numSegments] + length;
+
+        // Links sit at phase + index * spacing, count the ones in [begin, end)
+        const float offset = begin - wrapDistance(phase, length);
+        const int firstLink = (int)std::ceil((offset < 0.0f ? offset + length : offset) / spacing);
+        const int endLink = (int)std::ceil(((offset < 0.0f ? offset + length : offset) + (end - begin)) / spacing);
+        const int count = endLink - firstLink;
+
+        return FTrackLoopRange(firstLink % numLinks, count < numLinks ? count : numLinks);
+    }
+
+    void placeTrackLinks(const FTrackPath& path, float phase, int numLinks, float outwardOffset, const FTrackLoopRange& links, FTrackLinkTransform* outLinks)
+    {
+        assert(path.IsValid());
+        if(links.IsEmpty())
+        {
+            return;
+        }
+
+        const float length = path.GetLength();
+        const float spacing = length / (float)numLinks;
+        const int lastSegment = path.NumSegments() - 1;
+
+        float linkDistance = wrapDistance(phase + spacing * (float)links.First, length);
+        int segment = (int)(std::upper_bound(path.SegmentStart.begin(), path.SegmentStart.end() - 1, linkDistance) - path.SegmentStart.begin()) - 1;
+
+        for(int link = 0; link < links.Count; link++)
+        {
+            if(linkDistance >= length)
+            {
+                linkDistance -= length;
+                segment = 0;
+            }
+            while(segment < lastSegment && path.SegmentStart[segment + 1] <= linkDistance)
+            {
+                segment++;
+            }
+
+            FVec3 location;
+            FVec3 direction;
+            path.SampleSegment(segment, linkDistance - path.SegmentStart[segment], location, direction);
+
+            const FVec3 up = path.OutwardNormal(direction);
+            const FVec3 right = cross(up, direction);
+
+            outLinks[link].Location = location + up * outwardOffset;
+            outLinks[link].Rotation = quatFromAxes(direction, right, up);
+
+            linkDistance += spacing;
+        }
+    }
+}
@@ -0,0 +1,301 @@
+#include "Core/TrackedVehicleSimulation.h"
+#include "Core/TrackedDrivetrain.h"
+#include "Core/TrackedProfiler.h"
+#include "Core/TrackedSuspensionKernel.h"
+
+namespace TrackedCore
+{
+    void prepareInputAxis(FDrivetrainState& state, const FDrivetrainParams& params)
+    {
+        const FSkidSteerCommand command = mapSkidSteerInput(state.RawLeftTorque, state.RawRightTorque, state.TrackLeftAngVel, state.TrackRightAngVel, params.SkidSteer);
+        state.WheelLeftCoefficient = command.WheelLeftCoefficient;
+        state.WheelRightCoefficient = command.WheelRightCoefficient;
+        state.WheelForwardCoefficient = command.WheelForwardCoefficient;
+        state.BrakeRatioLeft = command.BrakeRatioLeft;
+        state.BrakeRatioRight = command.BrakeRatioRight;
+    }
+
+    void updateThrottle(FDrivetrainState& state, float dt)
+    {
+        state.TrackTorqueTransferRight = calculateTorqueTransfer(state.WheelRightCoefficient, state.WheelForwardCoefficient);
+        state.TrackTorqueTransferLeft = calculateTorqueTransfer(state.WheelLeftCoefficient, state.WheelForwardCoefficient);
+
+        state.ThrottleIncrement = calculateThrottleIncrement(state.TrackTorqueTransferRight, state.TrackTorqueTransferLeft);
+        state.Throttle = calculateThrottle(state.Throttle, state.ThrottleIncrement, dt);
+    }
+
+    void updateWheelsVelocity(FDrivetrainState& state, const FDrivetrainParams& params, float dt)
+    {
+        state.TrackRightTorque = state.DriveRightTorque + state.TrackFrictionTorqueRight + state.TrackRollingFrictionTorqueRight;
+        state.TrackLeftTorque = state.DriveLeftTorque + state.TrackFrictionTorqueLeft + state.TrackRollingFrictionTorqueLeft;
+
+        float trackRightVelInertia = calculateInertia(state.TrackRightAngVel, state.TrackRightTorque, params.MomentInertia, dt);
+        float trackLeftVelInertia = calculateInertia(state.TrackLeftAngVel, state.TrackLeftTorque, params.MomentInertia, dt);
+        state.TrackRightAngVel = calculateBrake(trackRightVelInertia, state.BrakeRatioRight, params.BrakeForce, dt);
+        state.TrackLeftAngVel = calculateBrake(trackLeftVelInertia, state.BrakeRatioLeft, params.BrakeForce, dt);
+
+        state.TrackRightLinVel = state.TrackRightAngVel * params.SprocketRadiusCm;
+        state.TrackLeftLinVel = state.TrackLeftAngVel * params.SprocketRadiusCm;
+    }
+
+    void updateAxleVelocity(FDrivetrainState& state)
+    {
+        state.AxleAngVel = calculateAxleAngularVelocity(state.TrackRightAngVel, state.TrackLeftAngVel);
+    }
+
+    float updateGear(FDrivetrainState& state, const FDrivetrainParams& params, float dt)
+    {
+        if(!params.Gearbox || !params.Gearbox->IsValid())
+        {
+            return params.GearRatio;
+        }
+
+        const FGearbox& gearbox = *params.Gearbox;
+        if(params.bAutoGearBox)
+        {
+            updateAutomaticGear(gearbox, state.Gearbox, state.AxleAngVel,
+                    (state.TrackLeftAngVel + state.TrackRightAngVel) * 0.5f,
+                    state.TrackTorqueTransferLeft + state.TrackTorqueTransferRight,
+                    dt);
+        }
+        else if(state.Gearbox.Gear < 0 || state.Gearbox.Gear >= (int)gearbox.Ratios.size())
+        {
+            state.Gearbox.Gear = gearbox.GetStartGear();
+        }
+        return gearbox.GetRatio(state.Gearbox.Gear);
+    }
+
+    void updateDriveTorque(FDrivetrainState& state, const FDrivetrainParams& params, float gearRatio)
+    {
+        // Transfer carries the direction of each track, the ratio only its magnitude
+        state.DriveAxleTorque = calculateDriveAxleTorque(state.EngineTorque, gearRatio, params.DiferentialRatio, params.TransmissionEfficiency) * params.EngineExtraPowerRatio;
+        state.DriveLeftTorque = state.DriveAxleTorque * state.TrackTorqueTransferLeft;
+        state.DriveRightTorque = state.DriveAxleTorque * state.TrackTorqueTransferRight;
+    }
+
+    void updateEngineAndDrive(FDrivetrainState& state, const FDrivetrainParams& params, float dt)
+    {
+        const bool baked = params.EngineTorque && params.EngineTorque->IsValid();
+        updateEngineAndDrive(state, params, dt, baked ? params.EngineTorque : nullptr);
+    }
+
+    void simulateDrivetrainStep(FDrivetrainState& state, const FDrivetrainParams& params, float dt)
+    {
+        updateThrottle(state, dt);
+        updateWheelsVelocity(state, params, dt);
+        updateAxleVelocity(state);
+        updateEngineAndDrive(state, params, dt);
+    }
+
+    void setSimulationLod(FVehicleSimulation& vehicle, ESimulationLod lod, int reducedStride)
+    {
+        vehicle.Lod = lod;
+        selectTracedUnits(vehicle.Suspensions, lod, reducedStride, vehicle.TracedUnits);
+        vehicle.ContactCache.Resize(vehicle.Suspensions.Num());
+    }
+
+    void gatherSuspensionTraces(FSuspensionStore& suspensions, const FVehicleFrame& frame, const std::vector<int>& tracedUnits, FSweepBatch& outTraces)
+    {
+        // Every unit needs its world pose, skipped ones are interpolated from it
+        for(int index = 0; index < suspensions.Num(); index++)
+        {
+            suspensions.WorldLocation[index] = frame.TransformLocation(suspensions.RootLocation[index]);
+            suspensions.WorldUp[index] = frame.TransformDirection(suspensions.LocalUp[index]);
+        }
+
+        const int count = (int)tracedUnits.size();
+        outTraces.Reset(count);
+
+        for(int trace = 0; trace < count; trace++)
+        {
+            const int index = tracedUnits[trace];
+
+            FSweepRequest& request = outTraces.Requests[trace];
+            request.Start = suspensions.WorldLocation[index];
+            request.End = suspensions.WorldLocation[index] + suspensions.WorldUp[index] * -suspensions.Length[index];
+            request.Radius = suspensions.Radius[index];
+        }
+    }
+
+    int consumeSuspensionTraces(FSuspensionStore& suspensions, const FSweepBatch& traces, const std::vector<int>& tracedUnits, const FSurfaceTable& surfaces)
+    {
+        int numContacts = 0;
+
+        // Both sides at once, left units come first in the store
+        for(int trace = 0; trace < traces.Num(); trace++)
+        {
+            const int index = tracedUnits[trace];
+            const FSweepRequest& request = traces.Requests[trace];
+            const FSweepHit& hit = traces.Hits[trace];
+
+            suspensions.Engaged[index] = hit.bHit ? 1 : 0;
+            if(hit.bHit)
+            {
+                suspensions.NewLength[index] = applySinkDepth(distance(request.Start, hit.Location), suspensions.Length[index], surfaces.Get(hit.SurfaceType));
+                suspensions.ContactPoint[index] = hit.ImpactPoint;
+                suspensions.ContactNormal[index] = hit.ImpactNormal;
+                suspensions.HitMaterial[index] = hit.SurfaceType;
+                numContacts++;
+            }
+            else
+            {
+                suspensions.NewLength[index] = suspensions.Length[index];
+                suspensions.ContactPoint[index] = FVec3();
+                suspensions.ContactNormal[index] = FVec3();
+                suspensions.HitMaterial[index] = 0;
+            }
+        }
+
+        if(traces.Num() < suspensions.Num())
+        {
+            interpolateSkippedUnits(suspensions, tracedUnits);
+
+            numContacts = 0;
+            for(int index = 0; index < suspensions.Num(); index++)
+            {
+                numContacts += suspensions.Engaged[index];
+            }
+        }
+
+        return numContacts;
+    }
+
+    void evaluateSuspensionForces(FSuspensionStore& suspensions, ESimulationLod lod, float targetVelocity, float dt, FForceAccumulator& bodyForces)
+    {
+        const int count = suspensions.Num();
+
+        // Kinematic hull only needs the new lengths to follow the ground
+        if(lod == ESimulationLod::Kinematic)
+        {
+            for(int index = 0; index < count; index++)
+            {
+                suspensions.PreviousLength[index] = suspensions.NewLength[index];
+                suspensions.Force[index] = FVec3();
+            }
+            return;
+        }
+
+        calculateSuspensionForceMagnitudes(
+            suspensions.Length.data(),
+            suspensions.NewLength.data(),
+            suspensions.PreviousLength.data(),
+            suspensions.Stiffness.data(),
+            suspensions.Damping.data(),
+            targetVelocity,
+            dt,
+            suspensions.ForceMagnitude.data(),
+            count);
+
+        for(int index = 0; index < count; index++)
+        {
+            suspensions.PreviousLength[index] = suspensions.NewLength[index];
+            suspensions.Force[index] = suspensions.Engaged[index]
+                ? suspensions.WorldUp[index] * suspensions.ForceMagnitude[index]
+                : FVec3();
+
+            if(suspensions.Engaged[index])
+            {
+                bodyForces.AddForceAtLocation(suspensions.Force[index], suspensions.WorldLocation[index]);
+            }
+        }
+    }
+
+    void updateTrackFriction(
+        FDrivetrainState& state,
+        const FDrivetrainParams& drivetrain,
+        ESimulationLod lod,
+        const FSuspensionStore& suspensions,
+        const FVehicleFrame& frame,
+        const FTrackFrictionParams& friction,
+        float gravityCm,
+        float dt,
+        FFrictionContactBatch& contacts,
+        FForceAccumulator& bodyForces)
+    {
+        FTrackFrictionResult result;
+        if(lod == ESimulationLod::Kinematic)
+        {
+            // Hull is moved by the caller, tracks drive it without slip
+            const float hullMassShare = frame.Mass * 0.5f;
+            const float wheelLoad = hullMassShare * std::fabs(gravityCm);
+            const float rollingFrictionCoef = averageRollingFrictionCoef(suspensions, *friction.Surfaces);
+            result.FrictionTorqueLeft = calculateNoSlipFrictionTorque(state.DriveLeftTorque, drivetrain.MomentInertia, hullMassShare, friction.SprocketRadiusCm);
+            result.FrictionTorqueRight = calculateNoSlipFrictionTorque(state.DriveRightTorque, drivetrain.MomentInertia, hullMassShare, friction.SprocketRadiusCm);
+            result.RollingFrictionTorqueLeft = calculateRollingFrictionTorque(state.TrackLeftAngVel, wheelLoad, rollingFrictionCoef, friction.SprocketRadiusCm);
+            result.RollingFrictionTorqueRight = calculateRollingFrictionTorque(state.TrackRightAngVel, wheelLoad, rollingFrictionCoef, friction.SprocketRadiusCm);
+        }
+        else
+        {
+            FTrackFrictionInputs inputs;
+            inputs.DriveTorqueLeft = state.DriveLeftTorque;
+            inputs.DriveTorqueRight = state.DriveRightTorque;
+            inputs.TrackLinVelLeft = state.TrackLeftLinVel;
+            inputs.TrackLinVelRight = state.TrackRightLinVel;
+            inputs.TrackAngVelLeft = state.TrackLeftAngVel;
+            inputs.TrackAngVelRight = state.TrackRightAngVel;
+            inputs.DT = dt;
+
+            // Every engaged contact of both tracks is solved in one batch
+            solveTrackFriction(suspensions, frame, friction, inputs, contacts, bodyForces, result);
+        }
+
+        state.TrackFrictionTorqueLeft = result.FrictionTorqueLeft;
+        state.TrackFrictionTorqueRight = result.FrictionTorqueRight;
+        state.TrackRollingFrictionTorqueLeft = result.RollingFrictionTorqueLeft;
+        state.TrackRollingFrictionTorqueRight = result.RollingFrictionTorqueRight;
+    }
+
+    void simulateVehicleTick(FVehicleSimulation& vehicle, IGroundQuery& ground, float dt)
+    {
+        {
+            TRACKEDCORE_PROFILE_SCOPE(BeginTick);
+            vehicle.BodyForces.Reset(vehicle.Frame.CenterOfMass);
+            prepareInputAxis(vehicle.Drivetrain, vehicle.Params);
+        }
+
+        {
+            TRACKEDCORE_PROFILE_SCOPE(Drivetrain);
+            simulateDrivetrainStep(vehicle.Drivetrain, vehicle.Params, dt);
+        }
+
+        {
+            TRACKEDCORE_PROFILE_SCOPE(GatherTraces);
+            gatherSuspensionTraces(vehicle.Suspensions, vehicle.Frame, vehicle.TracedUnits, vehicle.Traces);
+        }
+        {
+            TRACKEDCORE_PROFILE_SCOPE(ExecuteTraces);
+            if(vehicle.bReuseContacts)
+            {
+                // Flat or heightfield backends only hold static ground, every hit may be cached
+                vehicle.ContactCache.Prepare(vehicle.Traces, vehicle.TracedUnits, vehicle.ContactReuse);
+                ground.SweepBatch(vehicle.ContactCache.PendingSweeps);
+                vehicle.ContactCache.Resolve(vehicle.Traces, vehicle.TracedUnits);
+                vehicle.NumSweeps = vehicle.ContactCache.PendingSweeps.Num();
+            }
+            else
+            {
+                ground.SweepBatch(vehicle.Traces);
+                vehicle.NumSweeps = vehicle.Traces.Num();
+            }
+        }
+        {
+            TRACKEDCORE_PROFILE_SCOPE(ConsumeTraces);
+            vehicle.NumContacts = consumeSuspensionTraces(vehicle.Suspensions, vehicle.Traces, vehicle.TracedUnits, vehicle.Surfaces);
+        }
+        {
+            TRACKEDCORE_PROFILE_SCOPE(SuspensionForces);
+            evaluateSuspensionForces(vehicle.Suspensions, vehicle.Lod, vehicle.Params.SuspTargetVelocity, dt, vehicle.BodyForces);
+        }
+        {
+            TRACKEDCORE_PROFILE_SCOPE(Friction);
+            // Friction.Surfaces points at the vehicle's own table, which may have moved with it
+            FTrackFrictionParams friction = vehicle.Friction;
+            friction.Surfaces = &vehicle.Surfaces;
+            updateTrackFriction(vehicle.Drivetrain, vehicle.Params, vehicle.Lod, vehicle.Suspensions, vehicle.Frame, friction,
+                    vehicle.GravityCm, dt, vehicle.FrictionContacts, vehicle.BodyForces);
+        }
+
+        profileCounter(EProfileCounter::Traces, vehicle.NumSweeps);
+        profileCounter(EProfileCounter::EngagedContacts, vehicle.NumContacts);
+    }
+}
@@ -1,8 +1,35 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 #include "TrackedMovementComponent.h"
+#include "TrackedVehicleClass.h"
+#include "TrackedVehicleManager.h"
+#include "TrackedVehicles.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "TrackedMovementComponentStatics.h"
 #include "PhysicalMaterials/PhysicalMaterial.h"
+#include "GameFramework/PlayerController.h"
+#include "Engine/World.h"
+#include "Net/UnrealNetwork.h"
+#include "Core/TrackedFriction.h"
+#include "Core/TrackedReplayLog.h"
+#include "Core/TrackedSuspensionKernel.h"
+
+namespace
+{
+    // Replay log shared by every vehicle of the process, game thread only
+    struct FReplayRecording
+    {
+        TrackedCore::FReplayLogWriter Writer;
+        // Bumped per recording, vehicles write their setup again when it changed
+        uint32 Session = 0;
+        uint32 NextVehicleId = 0;
+    };
+
+    FReplayRecording& getReplayRecording()
+    {
+        static FReplayRecording recording;
+        return recording;
+    }
+}
 
 UTrackedMovementComponent::UTrackedMovementComponent(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer) {
@@ -14,17 +41,237 @@ UTrackedMovementComponent::UTrackedMovementComponent(const FObjectInitializer& O
 	// Air params
 	AirDensity = 1.2922f;
 
-	// Precalculate Moment of inertia based on mass and radius of suspension and mass of track
-	MomentInertia = PrecalculateMomentOfInertia(SprocketMassKg, SprocketRadiusCm, TrackMassKg);
-
-	// TODO: Register suspension handlers!
-	this->ConstructSuspension();
+	// Movement state goes out as quantized snapshots, see FTrackedReplicatedState
+	SetIsReplicated(true);
 
 	// TODO: Add center of mass visualization!
 	// this->SetupVisualizationCenterOfMass();
+}
+
+void UTrackedMovementComponent::OnRegister()
+{
+    Super::OnRegister();
 
-	// TODO: Create spline materials
-	// TODO: Build tracks spline
+    // Instance values are in place here, the constructor only sees the class defaults.
+    // A vehicle class brings its own prebuilt units at BeginPlay
+    if(!VehicleClass)
+    {
+        this->ConstructSuspension();
+    }
+}
+
+void UTrackedMovementComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    SuspensionQueryParams = makeSuspensionQueryParams(GetOwner());
+
+    if(VehicleClass)
+    {
+        this->ApplyVehicleClass();
+    }
+    else
+    {
+        MomentInertia = TrackedCore::precalculateMomentOfInertia(SprocketMassKg, SprocketRadiusCm, TrackMassKg);
+
+        this->BuildSurfaceTable();
+        this->BakeEngineTorqueTable();
+        this->BuildGearbox();
+    }
+
+    ReplicatedState.Quantization.MaxTrackAngVel = NetMaxTrackAngVel;
+    ReplicatedState.Quantization.SuspensionBits = FMath::Clamp(NetSuspensionBits, 1, 8);
+    if(ActiveEngineTorqueTable->IsValid())
+    {
+        ReplicatedState.Quantization.MaxEngineRPM = ActiveEngineTorqueTable->MaxTime;
+    }
+    else if(EngineTorqueCurve)
+    {
+        float minRPM;
+        EngineTorqueCurve->GetTimeRange(minRPM, ReplicatedState.Quantization.MaxEngineRPM);
+    }
+
+    if(ManagedTick)
+    {
+        // Manager drives every phase, own tick would simulate twice
+        SetComponentTickEnabled(false);
+        FTrackedVehicleManager::Get(GetWorld()).Register(this);
+    }
+}
+
+void UTrackedMovementComponent::BuildSurfaceTable()
+{
+    buildSurfaceTable(*this, SurfaceTable);
+    ActiveSurfaceTable = &SurfaceTable;
+}
+
+void UTrackedMovementComponent::BakeEngineTorqueTable()
+{
+    EngineTorqueTable.Reset();
+    ActiveEngineTorqueTable = &EngineTorqueTable;
+
+    if(BakeEngineTorqueCurve)
+    {
+        bakeEngineTorqueTable(*this, EngineTorqueTable);
+    }
+}
+
+void UTrackedMovementComponent::BuildGearbox()
+{
+    buildGearbox(*this, EngineTorqueTable, Gearbox);
+
+    ActiveGearbox = &Gearbox;
+    this->ResetGearbox();
+}
+
+void UTrackedMovementComponent::ResetGearbox()
+{
+    NeutralGearIndex = ActiveGearbox->NeutralGear;
+    CurrentGear = ActiveGearbox->GetStartGear();
+    ReverseGear = ActiveGearbox->IsReverse(CurrentGear);
+    LastAutoGearBoxAxleCheck = 0.0f;
+}
+
+void UTrackedMovementComponent::ApplyVehicleClass()
+{
+    check(VehicleClass);
+    if(!VehicleClass->HasDerivedData())
+    {
+        VehicleClass->BuildDerivedData();
+    }
+
+    // Scalars the tick reads, cheap to copy
+    TrackMassKg = VehicleClass->TrackMassKg;
+    SprocketMassKg = VehicleClass->SprocketMassKg;
+    SprocketRadiusCm = VehicleClass->SprocketRadiusCm;
+    TreadLenght = VehicleClass->TreadLenght;
+    SplineCoordinatesL = VehicleClass->SplineCoordinatesL;
+    SplineCoordinatesR = VehicleClass->SplineCoordinatesR;
+    SplineTangents = VehicleClass->SplineTangents;
+    TreadUVTiles = VehicleClass->TreadUVTiles;
+    TreadsOnSide = VehicleClass->TreadsOnSide;
+    TreadHalfThickness = VehicleClass->TreadHalfThickness;
+    GearRatios = VehicleClass->GearRatios;
+    DiferentialRatio = VehicleClass->DiferentialRatio;
+    TransmissionEfficiency = VehicleClass->TransmissionEfficiency;
+    BrakeForce = VehicleClass->BrakeForce;
+    EngineExtraPowerRatio = VehicleClass->EngineExtraPowerRatio;
+    AutoGearBox = VehicleClass->AutoGearBox;
+    GearUpShiftPrc = VehicleClass->GearUpShiftPrc;
+    GearDownShiftPrc = VehicleClass->GearDownShiftPrc;
+    GearShiftDelay = VehicleClass->GearShiftDelay;
+    EngineTorqueCurve = VehicleClass->EngineTorqueCurve;
+    InputDeadZone = VehicleClass->InputDeadZone;
+    InnerTrackBrake = VehicleClass->InnerTrackBrake;
+    CounterSpinBrakeAngVel = VehicleClass->CounterSpinBrakeAngVel;
+    MomentInertia = VehicleClass->GetMomentInertia();
+
+    // Tables stay in the asset, every vehicle of the model reads the same ones
+    ActiveSurfaceTable = &VehicleClass->GetSurfaceTable();
+    ActiveEngineTorqueTable = &VehicleClass->GetEngineTorqueTable();
+    ActiveGearbox = &VehicleClass->GetGearbox();
+    this->ResetGearbox();
+
+    if(VehicleClass->GetSuspensionTemplate().Num() > 0)
+    {
+        Suspensions = VehicleClass->GetSuspensionTemplate();
+        this->ResizeSuspensionState();
+    }
+
+    OnVehicleClassApplied.Broadcast();
+}
+
+void UTrackedMovementComponent::SetCurrentGear(int32 gear)
+{
+    if(GearRatios.IsValidIndex(gear))
+    {
+        CurrentGear = gear;
+        ReverseGear = ActiveGearbox->IsReverse(gear);
+        LastAutoGearBoxAxleCheck = 0.0f;
+    }
+}
+
+void UTrackedMovementComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if(ManagedTick)
+    {
+        FTrackedVehicleManager::Unregister(GetWorld(), this);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UTrackedMovementComponent::Activate(bool bReset)
+{
+    Super::Activate(bReset);
+
+    if(ManagedTick && HasBegunPlay())
+    {
+        SetComponentTickEnabled(false);
+        FTrackedVehicleManager::Get(GetWorld()).Register(this);
+    }
+}
+
+void UTrackedMovementComponent::Deactivate()
+{
+    if(ManagedTick)
+    {
+        FTrackedVehicleManager::Unregister(GetWorld(), this);
+    }
+
+    Super::Deactivate();
+}
+
+void UTrackedMovementComponent::ResetSimulationState()
+{
+    RawLeftTorque = RawRightTorque = 0.0f;
+    Throttle = ThrottleIncrement = 0.0f;
+    TrackLeftAngVel = TrackRightAngVel = 0.0f;
+    TrackLeftLinVel = TrackRightLinVel = 0.0f;
+    TrackLeftTorque = TrackRightTorque = 0.0f;
+    DriveLeftTorque = DriveRightTorque = 0.0f;
+    TrackFrictionTorqueLeft = TrackFrictionTorqueRight = 0.0f;
+    TrackRollingFrictionTorqueLeft = TrackRollingFrictionTorqueRight = 0.0f;
+    AxleAngVel = DriveAxleTorque = 0.0f;
+    EngineRPM = EngineTorque = 0.0f;
+    TreadMeshOffsetLeft = TreadMeshOffsetRight = 0.0f;
+    TreadStepDeltaLeft = TreadStepDeltaRight = 0.0f;
+    VisualTreadOffsetLeft = VisualTreadOffsetRight = 0.0f;
+    TreadUVOffsetLeft = TreadUVOffsetRight = 0.0f;
+    this->ResetGearbox();
+
+    StepAccumulator.Reset();
+    Sleep.Wake();
+    this->ResetNetState();
+    SuspensionTraceHandles.Reset();
+    ReactionForces.Reset();
+
+    // Keeps the units and every array size, a recycled vehicle allocates nothing
+    Suspensions.ResetState();
+    ContactCache.InvalidateAll();
+    for(TWeakObjectPtr<UPrimitiveComponent>& hitComponent : SuspensionHitComponents)
+    {
+        hitComponent.Reset();
+    }
+
+    // Out of Kinematic this hands the body back to physics, at rest since the tracks are stopped
+    this->SetSimulationLod(TrackedCore::ESimulationLod::Full);
+}
+
+void UTrackedMovementComponent::ResetNetState()
+{
+    NetInputSequence = 0;
+    bAcceptNextNetInput = true;
+    NetPendingInputs.Reset();
+    bNetInputPending = false;
+    ReplicatedState.Reset();
+}
+
+void UTrackedMovementComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+    Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+    DOREPLIFETIME(UTrackedMovementComponent, ReplicatedState);
 }
 
 void UTrackedMovementComponent::SetLeftTorque(float power)
@@ -37,291 +284,979 @@ void UTrackedMovementComponent::SetRightTorque(float power)
     RawRightTorque = power;
 }
 
+void UTrackedMovementComponent::SetTorques(float left, float right)
+{
+    RawLeftTorque = left;
+    RawRightTorque = right;
+}
+
+void UTrackedMovementComponent::SetInputsBatch(const TArray<UTrackedMovementComponent*>& Vehicles, const TArray<FTrackedVehicleInput>& Inputs)
+{
+    if(Vehicles.Num() != Inputs.Num())
+    {
+        UE_LOG(LogTrackedVehicles, Warning, TEXT("SetInputsBatch: %d vehicles but %d inputs, extra entries ignored"), Vehicles.Num(), Inputs.Num());
+    }
+
+    SetInputs(Vehicles.GetData(), Inputs.GetData(), FMath::Min(Vehicles.Num(), Inputs.Num()));
+}
+
+void UTrackedMovementComponent::SetInputs(UTrackedMovementComponent* const* vehicles, const FTrackedVehicleInput* inputs, int32 count)
+{
+    // Plain stores, mapped onto the drivetrain by each vehicle's own PrepareInputAxis
+    for(int32 index = 0; index < count; index++)
+    {
+        if(UTrackedMovementComponent* vehicle = vehicles[index])
+        {
+            vehicle->RawLeftTorque = inputs[index].Left;
+            vehicle->RawRightTorque = inputs[index].Right;
+        }
+    }
+}
+
 void UTrackedMovementComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
+    // Same phases FTrackedVehicleManager runs in parallel batches for managed vehicles
+    this->BeginSimulationTick(DeltaTime);
+    this->SimulateDrivetrain(DeltaTime);
+
+    // Track links and tread materials follow the visual offsets in UTracksBuilderComponent
+    this->CalculateCollisions();
+    this->ApplyDriveForcesAndGetFrictionForcesOnSides();
+    this->ApplyAccumulatedForces();
+    this->FollowGroundKinematic();
+    this->CaptureNetState();
+    this->RecordReplayTick();
+};
+
+void UTrackedMovementComponent::BeginSimulationTick(float DeltaTime)
+{
+    TRACKED_PHASE_SCOPE(STAT_TrackedBeginTick, BeginTick);
+
     TotalNumFrictionPoints = 0.0f;
 
-    this->DT = DeltaTime;
+    this->SendNetInput(DeltaTime);
+    this->CaptureVehicleFrame();
+    this->UpdateSimulationLod();
+    this->UpdateSleep(DeltaTime);
+    if(Sleep.bAsleep)
+    {
+        TRACKED_COUNTER(STAT_TrackedSleepingVehicles, SleepingVehicles, 1);
+    }
+    BodyForces.Reset(Frame.CenterOfMass);
     this->PrepareInputAxis();
-	//   0: PutToSleep                                          TODO
+}
+
+void UTrackedMovementComponent::UpdateSimulationLod()
+{
+    TrackedCore::ESimulationLod lod = TrackedCore::ESimulationLod::Full;
+
+    if(DistanceLod)
+    {
+        TrackedCore::FSimulationLodSettings settings;
+        settings.ReducedDistance = LodReducedDistance;
+        settings.KinematicDistance = LodKinematicDistance;
+        settings.Hysteresis = LodHysteresis;
+        settings.ReducedStride = LodReducedStride;
+
+        lod = TrackedCore::selectSimulationLod(this->GetClosestViewerDistance(), SimulationLod, settings);
+    }
+
+    this->SetSimulationLod(lod);
+
+    // Body is not simulated, the hull moves with its tracks
+    if(SimulationLod == TrackedCore::ESimulationLod::Kinematic)
+    {
+        Frame.LinearVelocity = Frame.Forward * ((TrackLeftLinVel + TrackRightLinVel) * 0.5f);
+        Frame.AngularVelocity = TrackedCore::FVec3();
+    }
+}
+
+void UTrackedMovementComponent::SetSimulationLod(TrackedCore::ESimulationLod lod)
+{
+    if(lod == SimulationLod)
+    {
+        return;
+    }
+
+    // Simulated proxies take the body from replication, only the simulating side hands it over
+    const bool bOwnsBody = GetOwnerRole() == ROLE_Authority || GetOwnerRole() == ROLE_AutonomousProxy;
+    if(bOwnsBody && lod == TrackedCore::ESimulationLod::Kinematic)
+    {
+        UpdatedPrimitive->SetSimulatePhysics(false);
+    }
+    else if(bOwnsBody && SimulationLod == TrackedCore::ESimulationLod::Kinematic)
+    {
+        // Hand the kinematic motion over to the body
+        UpdatedPrimitive->SetSimulatePhysics(true);
+        UpdatedPrimitive->SetPhysicsLinearVelocity(toEngine(Frame.Forward * ((TrackLeftLinVel + TrackRightLinVel) * 0.5f)), false, NAME_None);
+    }
+
+    SimulationLod = lod;
+    TrackedCore::selectTracedUnits(Suspensions, SimulationLod, LodReducedStride, TracedSuspensionUnits.Units);
+
+    // In flight sweeps and cached contacts belong to the previous unit selection
+    SuspensionTraceHandles.Reset();
+    ContactCache.InvalidateAll();
+}
+
+float UTrackedMovementComponent::GetClosestViewerDistance() const
+{
+    // No viewer at all (empty server) counts as infinitely far
+    float closestDistance = MAX_FLT;
+    const FVector location = toEngine(Frame.Location);
+
+    for(FConstPlayerControllerIterator iterator = GetWorld()->GetPlayerControllerIterator(); iterator; ++iterator)
+    {
+        APlayerController* playerController = iterator->Get();
+        if(!playerController)
+        {
+            continue;
+        }
+
+        FVector viewLocation;
+        FRotator viewRotation;
+        playerController->GetPlayerViewPoint(viewLocation, viewRotation);
+        closestDistance = FMath::Min(closestDistance, FVector::Dist(viewLocation, location));
+    }
+
+    return closestDistance;
+}
+
+void UTrackedMovementComponent::UpdateSleep(float DeltaTime)
+{
+    if(!AllowSleep)
+    {
+        Sleep.Wake();
+        return;
+    }
+
+    // Something pushed the resting body, simulate again
+    if(Sleep.bAsleep && UpdatedPrimitive->IsSimulatingPhysics(NAME_None) && UpdatedPrimitive->RigidBodyIsAwake(NAME_None))
+    {
+        Sleep.Wake();
+    }
+
+    const bool hasInput = FMath::Abs(RawLeftTorque) > TrackedCore::Epsilon || FMath::Abs(RawRightTorque) > TrackedCore::Epsilon;
+    const bool atRest = !hasInput && TrackedCore::isVehicleAtRest(Frame.LinearVelocity, Frame.AngularVelocity, TrackLeftLinVel, TrackRightLinVel, SleepVelocity);
+
+    if(Sleep.Update(atRest, SleepTimerSeconds, DeltaTime))
+    {
+        this->PutToSleep();
+    }
+}
+
+void UTrackedMovementComponent::PutToSleep()
+{
+    // Wake up from a standstill
+    Throttle = 0.0f;
+    TrackLeftAngVel = TrackRightAngVel = 0.0f;
+    TrackLeftLinVel = TrackRightLinVel = 0.0f;
+    DriveLeftTorque = DriveRightTorque = 0.0f;
+    TrackFrictionTorqueLeft = TrackFrictionTorqueRight = 0.0f;
+    TrackRollingFrictionTorqueLeft = TrackRollingFrictionTorqueRight = 0.0f;
+    AxleAngVel = 0.0f;
+    StepAccumulator.Reset();
+    SuspensionTraceHandles.Reset();
+
+    if(UpdatedPrimitive->IsSimulatingPhysics(NAME_None))
+    {
+        UpdatedPrimitive->PutRigidBodyToSleep(NAME_None);
+    }
+}
+
+void UTrackedMovementComponent::SimulateDrivetrain(float DeltaTime)
+{
+    TRACKED_PHASE_SCOPE(STAT_TrackedDrivetrain, Drivetrain);
+
+    if(Sleep.bAsleep)
+    {
+        this->RecordNetInputSteps(0);
+        return;
+    }
+
+    if(FixedTimestep)
+    {
+        StepAccumulator.StepSeconds = FixedTimestepSeconds;
+        StepAccumulator.MaxSubsteps = MaxSubsteps;
+
+        const int steps = StepAccumulator.Advance(DeltaTime);
+        this->RecordNetInputSteps(steps);
+
+        this->DT = FixedTimestepSeconds;
+        for(int step = 0; step < steps; step++)
+        {
+            this->SimulateDrivetrainStep();
+        }
+
+        // Render between the last two steps
+        const float alpha = StepAccumulator.Alpha();
+        VisualTreadOffsetRight = TrackedCore::wrapTreadOffset(TreadMeshOffsetRight - TreadStepDeltaRight * (1.0f - alpha), TreadLenght);
+        VisualTreadOffsetLeft = TrackedCore::wrapTreadOffset(TreadMeshOffsetLeft - TreadStepDeltaLeft * (1.0f - alpha), TreadLenght);
+
+        // Forces are applied once per frame, a hitch must not feed the damper a huge step
+        this->DT = FMath::Min(DeltaTime, FixedTimestepSeconds * MaxSubsteps);
+    }
+    else
+    {
+        this->DT = DeltaTime;
+        this->SimulateDrivetrainStep();
+        this->RecordNetInputSteps(1);
+
+        VisualTreadOffsetRight = TreadMeshOffsetRight;
+        VisualTreadOffsetLeft = TreadMeshOffsetLeft;
+    }
+
+    this->UpdateTreadUVOffsets();
+}
+
+void UTrackedMovementComponent::SimulateDrivetrainStep()
+{
     this->UpdateThrottle();
     this->UpdateWheelsVelocity();
     // 103: AnimateWheels
-    // 104: AnimateThreadsMaterial
-    // 105: AnimateThreadsSpline
-    // 106: AnimateThreadsInstanciatedMesh
+    this->UpdateTreadOffsets();
     this->UpdateAxleVelocity();
     this->UpdateEngineAndUpdateDrive();
-    this->CalculateCollisions();
-    this->ApplyDriveForcesAndGetFrictionForcesOnSides();
-};
+}
+
+void UTrackedMovementComponent::MakeDrivetrainParams(TrackedCore::FDrivetrainParams& outParams) const
+{
+    outParams.MomentInertia = MomentInertia;
+    outParams.SprocketRadiusCm = SprocketRadiusCm;
+    outParams.BrakeForce = BrakeForce;
+    outParams.DiferentialRatio = DiferentialRatio;
+    outParams.TransmissionEfficiency = TransmissionEfficiency;
+    outParams.EngineExtraPowerRatio = EngineExtraPowerRatio;
+    outParams.Gearbox = ActiveGearbox;
+    outParams.bAutoGearBox = AutoGearBox;
+    outParams.SuspTargetVelocity = SuspTargetVelocity;
+    outParams.EngineTorque = ActiveEngineTorqueTable;
+    outParams.SkidSteer.DeadZone = InputDeadZone;
+    outParams.SkidSteer.InnerTrackBrake = InnerTrackBrake;
+    outParams.SkidSteer.CounterSpinAngVel = CounterSpinBrakeAngVel;
+}
+
+void UTrackedMovementComponent::ReadDrivetrainState(TrackedCore::FDrivetrainState& outState) const
+{
+    outState.RawLeftTorque = RawLeftTorque;
+    outState.RawRightTorque = RawRightTorque;
+    outState.WheelLeftCoefficient = WheelLeftCoefficient;
+    outState.WheelRightCoefficient = WheelRightCoefficient;
+    outState.WheelForwardCoefficient = WheelForwardCoefficient;
+    outState.BrakeRatioLeft = BrakeRatioLeft;
+    outState.BrakeRatioRight = BrakeRatioRight;
+    outState.TrackTorqueTransferLeft = TrackTorqueTransferLeft;
+    outState.TrackTorqueTransferRight = TrackTorqueTransferRight;
+    outState.Throttle = Throttle;
+    outState.ThrottleIncrement = ThrottleIncrement;
+    outState.DriveLeftTorque = DriveLeftTorque;
+    outState.DriveRightTorque = DriveRightTorque;
+    outState.TrackFrictionTorqueLeft = TrackFrictionTorqueLeft;
+    outState.TrackFrictionTorqueRight = TrackFrictionTorqueRight;
+    outState.TrackRollingFrictionTorqueLeft = TrackRollingFrictionTorqueLeft;
+    outState.TrackRollingFrictionTorqueRight = TrackRollingFrictionTorqueRight;
+    outState.TrackLeftTorque = TrackLeftTorque;
+    outState.TrackRightTorque = TrackRightTorque;
+    outState.TrackLeftAngVel = TrackLeftAngVel;
+    outState.TrackRightAngVel = TrackRightAngVel;
+    outState.TrackLeftLinVel = TrackLeftLinVel;
+    outState.TrackRightLinVel = TrackRightLinVel;
+    outState.AxleAngVel = AxleAngVel;
+    outState.EngineRPM = EngineRPM;
+    outState.EngineTorque = EngineTorque;
+    outState.DriveAxleTorque = DriveAxleTorque;
+    outState.Gearbox.Gear = CurrentGear;
+    outState.Gearbox.bReverse = ReverseGear;
+    outState.Gearbox.TimeSinceShift = LastAutoGearBoxAxleCheck;
+}
+
+void UTrackedMovementComponent::WriteDrivetrainState(const TrackedCore::FDrivetrainState& state)
+{
+    RawLeftTorque = state.RawLeftTorque;
+    RawRightTorque = state.RawRightTorque;
+    WheelLeftCoefficient = state.WheelLeftCoefficient;
+    WheelRightCoefficient = state.WheelRightCoefficient;
+    WheelForwardCoefficient = state.WheelForwardCoefficient;
+    BrakeRatioLeft = state.BrakeRatioLeft;
+    BrakeRatioRight = state.BrakeRatioRight;
+    TrackTorqueTransferLeft = state.TrackTorqueTransferLeft;
+    TrackTorqueTransferRight = state.TrackTorqueTransferRight;
+    Throttle = state.Throttle;
+    ThrottleIncrement = state.ThrottleIncrement;
+    DriveLeftTorque = state.DriveLeftTorque;
+    DriveRightTorque = state.DriveRightTorque;
+    TrackFrictionTorqueLeft = state.TrackFrictionTorqueLeft;
+    TrackFrictionTorqueRight = state.TrackFrictionTorqueRight;
+    TrackRollingFrictionTorqueLeft = state.TrackRollingFrictionTorqueLeft;
+    TrackRollingFrictionTorqueRight = state.TrackRollingFrictionTorqueRight;
+    TrackLeftTorque = state.TrackLeftTorque;
+    TrackRightTorque = state.TrackRightTorque;
+    TrackLeftAngVel = state.TrackLeftAngVel;
+    TrackRightAngVel = state.TrackRightAngVel;
+    TrackLeftLinVel = state.TrackLeftLinVel;
+    TrackRightLinVel = state.TrackRightLinVel;
+    AxleAngVel = state.AxleAngVel;
+    EngineRPM = state.EngineRPM;
+    EngineTorque = state.EngineTorque;
+    DriveAxleTorque = state.DriveAxleTorque;
+    CurrentGear = state.Gearbox.Gear;
+    ReverseGear = state.Gearbox.bReverse;
+    LastAutoGearBoxAxleCheck = state.Gearbox.TimeSinceShift;
+}
+
+void UTrackedMovementComponent::CaptureVehicleFrame()
+{
+    captureVehicleFrame(GetOwner(), UpdatedPrimitive, Frame);
+    GravityCm = FMath::Abs(GetWorld()->GetGravityZ());
+}
+
+void UTrackedMovementComponent::PrepareInputAxis()
+{
+    TrackedCore::FDrivetrainParams params;
+    this->MakeDrivetrainParams(params);
 
-void UTrackedMovementComponent::PrepareInputAxis() {
-    // Move?
-    if(fabs(RawLeftTorque) > EPSILON && fabs(RawRightTorque) > EPSILON)
+    TrackedCore::FDrivetrainState state;
+    this->ReadDrivetrainState(state);
+    TrackedCore::prepareInputAxis(state, params);
+    this->WriteDrivetrainState(state);
+}
+
+void UTrackedMovementComponent::SendNetInput(float DeltaTime)
+{
+    if(GetOwnerRole() != ROLE_AutonomousProxy)
     {
-        /*
-         *  LEFT     RIGHT
-         *  +1.0  +  -0.2
-         *  -0.2  +  +1.0
-         *  +0.5  +  -1.0
-         *
-         *
-         *
-         *
-         */
+        return;
+    }
 
+    FTrackedNetInput input;
+    input.Sequence = ++NetInputSequence;
+    input.Left = RawLeftTorque;
+    input.Right = RawRightTorque;
+    this->ServerSetInput(input);
 
-        if((RawLeftTorque + RawRightTorque) > 0.0f)
-        {
-            // Forward
+    if(PredictOwnerMovement)
+    {
+        TrackedCore::FNetInput pending;
+        pending.Sequence = input.Sequence;
+        pending.Left = RawLeftTorque;
+        pending.Right = RawRightTorque;
+        pending.DeltaTime = DeltaTime;
+        NetPendingInputs.Add(pending);
+        bNetInputPending = true;
+    }
+}
 
-        }
-        else
-        {
-            // Backward
+bool UTrackedMovementComponent::ServerSetInput_Validate(const FTrackedNetInput& Input)
+{
+    // Inputs arrive quantized into [-1, 1]
+    return true;
+}
 
-        }
+void UTrackedMovementComponent::ServerSetInput_Implementation(const FTrackedNetInput& Input)
+{
+    // Unreliable, a late input must not undo a newer one. After a reset the owner's
+    // counter is unrelated to ours, its first input sets where we count from
+    if(bAcceptNextNetInput || TrackedCore::isNewerSequence(Input.Sequence, NetInputSequence))
+    {
+        bAcceptNextNetInput = false;
+        NetInputSequence = Input.Sequence;
+        RawLeftTorque = Input.Left;
+        RawRightTorque = Input.Right;
     }
-    else
+}
+
+void UTrackedMovementComponent::CaptureNetState()
+{
+    if(GetOwnerRole() != ROLE_Authority || GetNetMode() == NM_Standalone)
     {
-        // Set full brake
+        return;
     }
 
-//    WheelRightCoefficient = LatestRightAxis;
-//    WheelLeftCoefficient = -LatestRightAxis;//
-//    float rightWeight = LatestRightAxis > 0 ? 1.0f : -1.0f;
-//    float leftWeight  = LatestRightAxis < 0 ? 1.0f : -1.0f;
+    TrackedCore::FNetVehicleState state;
+    state.TrackLeftAngVel = TrackLeftAngVel;
+    state.TrackRightAngVel = TrackRightAngVel;
+    state.Throttle = Throttle;
+    state.EngineRPM = EngineRPM;
+    state.InputLeft = RawLeftTorque;
+    state.InputRight = RawRightTorque;
+    state.Gear = ActiveGearbox->IsValid() ? CurrentGear : -1;
+    state.bReverse = ReverseGear;
+    state.bAsleep = Sleep.bAsleep;
+
+    TrackedCore::FVehicleNetSnapshot& snapshot = ReplicatedState.Latest;
+    TrackedCore::quantizeNetState(state, Suspensions, ReplicatedState.Quantization, snapshot);
+    snapshot.Sequence++;
+    snapshot.LastInput = NetInputSequence;
 }
 
-void UTrackedMovementComponent::UpdateThrottle()
+bool UTrackedMovementComponent::StartReplayRecording(const FString& Path)
 {
-    // TODO: Move magic numbers to constants
-    TrackTorqueTransferRight = FMath::Clamp(WheelRightCoefficient + WheelForwardCoefficient, -1.0f, 2.0f);
-    TrackTorqueTransferLeft = FMath::Clamp(WheelLeftCoefficient + WheelForwardCoefficient, -1.0f, 2.0f);
+    check(IsInGameThread());
 
+    FReplayRecording& recording = getReplayRecording();
+    if(!recording.Writer.Open(TCHAR_TO_UTF8(*Path)))
+    {
+        UE_LOG(LogTrackedVehicles, Warning, TEXT("StartReplayRecording: cannot write %s"), *Path);
+        return false;
+    }
 
-    // TODO: Epsilon compare
-    if( fmax(fabs(TrackTorqueTransferRight), fabs(TrackTorqueTransferLeft)) != 0.0f )
+    recording.Session++;
+    recording.NextVehicleId = 0;
+    return true;
+}
+
+void UTrackedMovementComponent::StopReplayRecording()
+{
+    check(IsInGameThread());
+
+    FReplayRecording& recording = getReplayRecording();
+    if(recording.Writer.IsOpen() && !recording.Writer.Close())
     {
-        ThrottleIncrement = 0.5f;
+        UE_LOG(LogTrackedVehicles, Warning, TEXT("StopReplayRecording: replay log is incomplete, a write failed"));
     }
-    else
+}
+
+void UTrackedMovementComponent::RecordReplayTick()
+{
+    FReplayRecording& recording = getReplayRecording();
+    if(!recording.Writer.IsOpen() || Sleep.bAsleep)
     {
-        ThrottleIncrement = -1.0f;
+        return;
     }
 
-    Throttle = FMath::Clamp(Throttle + ThrottleIncrement * DT, 0.0f, 1.0f);
-};
+    if(ReplayRecordingSession != recording.Session)
+    {
+        ReplayRecordingSession = recording.Session;
+        ReplayVehicleId = recording.NextVehicleId++;
 
-void UTrackedMovementComponent::UpdateWheelsVelocity()
+        TrackedCore::FDrivetrainParams params;
+        this->MakeDrivetrainParams(params);
+
+        // An unbaked torque curve is recorded as an empty table, the replay drives without engine torque
+        TrackedCore::FReplayVehicleSetup setup;
+        TrackedCore::captureReplayVehicleSetup(params, ActiveGearbox, ActiveEngineTorqueTable, *ActiveSurfaceTable, SprocketRadiusCm, LodReducedStride, Suspensions, setup);
+        recording.Writer.WriteVehicle(ReplayVehicleId, setup);
+    }
+
+    TrackedCore::FReplayVehicleTick tick;
+    tick.VehicleId = ReplayVehicleId;
+    tick.DeltaTime = DT;
+    tick.RawLeftTorque = RawLeftTorque;
+    tick.RawRightTorque = RawRightTorque;
+    tick.Lod = SimulationLod;
+    tick.Frame = Frame;
+    tick.Hits = SuspensionTraces.Hits.data();
+    tick.NumHits = SuspensionTraces.Num();
+    recording.Writer.WriteTick(tick);
+}
+
+void UTrackedMovementComponent::OnRep_ReplicatedState()
 {
-    // TODO: Vector Math against float add
+    this->ApplyNetState();
 
-    // calculate torgues for tracks
-    TrackRightTorque = DriveRightTorque + TrackFrictionTorqueRight + TrackRollingFrictionTorqueRight;
-    TrackLeftTorque = DriveLeftTorque + TrackFrictionTorqueLeft + TrackRollingFrictionTorqueLeft;
+    if(GetOwnerRole() == ROLE_AutonomousProxy && PredictOwnerMovement)
+    {
+        NetPendingInputs.Acknowledge(ReplicatedState.Latest.LastInput);
+        this->ReplayNetInputs();
+    }
+}
 
-    // apply brake coff to angular velocities
-    float trackRightVelInertia = calculateInertia(TrackRightAngVel, TrackRightTorque, MomentInertia, DT);
-    float trackLeftVelInertia = calculateInertia(TrackLeftAngVel, TrackLeftTorque, MomentInertia, DT);
-    TrackRightAngVel = calculateBrake(trackRightVelInertia, BrakeRatioRight, BrakeForce, DT);
-    TrackLeftAngVel = calculateBrake(trackLeftVelInertia, BrakeRatioLeft, BrakeForce, DT);
+void UTrackedMovementComponent::ApplyNetState()
+{
+    TrackedCore::FNetVehicleState state;
+    TrackedCore::dequantizeNetState(ReplicatedState.Latest, ReplicatedState.Quantization, state, Suspensions);
 
-    TrackRightLinVel = TrackRightAngVel * SprocketRadiusCm;
+    TrackLeftAngVel = state.TrackLeftAngVel;
+    TrackRightAngVel = state.TrackRightAngVel;
     TrackLeftLinVel = TrackLeftAngVel * SprocketRadiusCm;
-};
+    TrackRightLinVel = TrackRightAngVel * SprocketRadiusCm;
+    AxleAngVel = TrackedCore::calculateAxleAngularVelocity(TrackRightAngVel, TrackLeftAngVel);
+    Throttle = state.Throttle;
+    EngineRPM = state.EngineRPM;
+    if(ActiveGearbox->IsValid() && GearRatios.IsValidIndex(state.Gear))
+    {
+        CurrentGear = state.Gear;
+        ReverseGear = state.bReverse;
+    }
+
+    // Simulated proxies keep driving with the server inputs between snapshots
+    if(GetOwnerRole() == ROLE_SimulatedProxy)
+    {
+        RawLeftTorque = state.InputLeft;
+        RawRightTorque = state.InputRight;
+
+        if(state.bAsleep && !Sleep.bAsleep)
+        {
+            Sleep.bAsleep = true;
+            this->PutToSleep();
+        }
+        else if(!state.bAsleep && Sleep.bAsleep)
+        {
+            Sleep.Wake();
+        }
+    }
+}
+
+void UTrackedMovementComponent::ReplayNetInputs()
+{
+    // Treads are cosmetic and already moved locally, replay only the drivetrain
+    const float rawLeftTorque = RawLeftTorque;
+    const float rawRightTorque = RawRightTorque;
+    const float treadMeshOffsetLeft = TreadMeshOffsetLeft;
+    const float treadMeshOffsetRight = TreadMeshOffsetRight;
+    const float deltaTime = DT;
+
+    for(int index = 0; index < NetPendingInputs.Num(); index++)
+    {
+        const TrackedCore::FNetInput& input = NetPendingInputs[index];
+        RawLeftTorque = input.Left;
+        RawRightTorque = input.Right;
+        this->PrepareInputAxis();
+
+        // Exactly the steps the frame ran when it was simulated first
+        this->DT = FixedTimestep ? FixedTimestepSeconds : input.DeltaTime;
+        for(int step = 0; step < input.Steps; step++)
+        {
+            this->SimulateDrivetrainStep();
+        }
+    }
+
+    RawLeftTorque = rawLeftTorque;
+    RawRightTorque = rawRightTorque;
+    TreadMeshOffsetLeft = treadMeshOffsetLeft;
+    TreadMeshOffsetRight = treadMeshOffsetRight;
+    this->DT = deltaTime;
+}
+
+void UTrackedMovementComponent::RecordNetInputSteps(int steps)
+{
+    if(bNetInputPending && NetPendingInputs.Num() > 0)
+    {
+        NetPendingInputs.Newest().Steps = steps;
+    }
+    bNetInputPending = false;
+}
+
+void UTrackedMovementComponent::UpdateThrottle()
+{
+    TrackedCore::FDrivetrainState state;
+    this->ReadDrivetrainState(state);
+    TrackedCore::updateThrottle(state, DT);
+    this->WriteDrivetrainState(state);
+}
+
+void UTrackedMovementComponent::UpdateWheelsVelocity()
+{
+    TrackedCore::FDrivetrainParams params;
+    this->MakeDrivetrainParams(params);
+
+    TrackedCore::FDrivetrainState state;
+    this->ReadDrivetrainState(state);
+    TrackedCore::updateWheelsVelocity(state, params, DT);
+    this->WriteDrivetrainState(state);
+}
+
+void UTrackedMovementComponent::UpdateTreadOffsets()
+{
+    TreadStepDeltaRight = TrackRightLinVel * DT;
+    TreadStepDeltaLeft = TrackLeftLinVel * DT;
+
+    TreadMeshOffsetRight = TrackedCore::wrapTreadOffset(TreadMeshOffsetRight + TreadStepDeltaRight, TreadLenght);
+    TreadMeshOffsetLeft = TrackedCore::wrapTreadOffset(TreadMeshOffsetLeft + TreadStepDeltaLeft, TreadLenght);
+}
+
+void UTrackedMovementComponent::UpdateTreadUVOffsets()
+{
+    TreadUVOffsetRight = TrackedCore::treadUVOffset(VisualTreadOffsetRight, TreadLenght, TreadUVTiles);
+    TreadUVOffsetLeft = TrackedCore::treadUVOffset(VisualTreadOffsetLeft, TreadLenght, TreadUVTiles);
+}
 
 void UTrackedMovementComponent::UpdateAxleVelocity()
 {
-    AxleAngVel = (fabs(TrackRightAngVel) + fabs(TrackLeftAngVel)) / 2.0f;
+    TrackedCore::FDrivetrainState state;
+    this->ReadDrivetrainState(state);
+    TrackedCore::updateAxleVelocity(state);
+    this->WriteDrivetrainState(state);
 }
 
 void UTrackedMovementComponent::UpdateEngineAndUpdateDrive()
 {
-    // TODO: Calculate CurrentGearRatio
-//    EngineRPM = clampEngineRPM(calculateEngineRPM(AxleAngVel, CurrentGearRatio, DiferentialRatio), *EngineTorqueCurve);
-    EngineRPM = clampEngineRPM(calculateEngineRPM(AxleAngVel, 1.0f, DiferentialRatio), EngineTorqueCurve);
-    EngineTorque = calculateEngineTorque(EngineRPM, EngineTorqueCurve) * Throttle;
+    TrackedCore::FDrivetrainParams params;
+    this->MakeDrivetrainParams(params);
+
+    TrackedCore::FDrivetrainState state;
+    this->ReadDrivetrainState(state);
+
+    // Without a baked table the torque curve is sampled directly
+    if(!ActiveEngineTorqueTable->IsValid() && EngineTorqueCurve)
+    {
+        const FEngineTorqueCurve curve = { EngineTorqueCurve };
+        TrackedCore::updateEngineAndDrive(state, params, DT, &curve);
+    }
+    else
+    {
+        TrackedCore::updateEngineAndDrive(state, params, DT);
+    }
+    this->WriteDrivetrainState(state);
 }
 
 void UTrackedMovementComponent::ConstructSuspension()
 {
-	for (int leftIndex = 0; leftIndex < SuspHandleLeft.Num(); leftIndex++)
+    Suspensions.Reset();
+    Suspensions.Reserve(SuspesionSetupL.Num() + SuspesionSetupR.Num());
+
+    // Left units first, store keeps them packed in front of the right ones.
+    // A registered handle places its unit, RootLoc and RootRot of the setup otherwise
+	for (int leftIndex = 0; leftIndex < SuspesionSetupL.Num(); leftIndex++)
     {
-		setupSuspensionHandlersArray(&SuspensionsInternalLeft, SuspesionSetupL[leftIndex], SuspHandleLeft[leftIndex]);
+        const FSuspensionSetup& setup = SuspesionSetupL[leftIndex];
+        if(SuspHandleLeft.IsValidIndex(leftIndex) && SuspHandleLeft[leftIndex])
+        {
+            setupSuspensionUnit(Suspensions, TrackedCore::ETrackSide::Left, setup, SuspHandleLeft[leftIndex]);
+        }
+        else
+        {
+            Suspensions.Add(TrackedCore::ETrackSide::Left, toSuspensionUnitSetup(setup, setup.RootLoc, setup.RootRot.Quaternion()));
+        }
 	}
 
-	for (int rightIndex = 0; rightIndex < SuspHandleRight.Num(); rightIndex++)
+	for (int rightIndex = 0; rightIndex < SuspesionSetupR.Num(); rightIndex++)
     {
-		setupSuspensionHandlersArray(&SuspensionsInternalRight, SuspesionSetupR[rightIndex], SuspHandleRight[rightIndex]);
+        const FSuspensionSetup& setup = SuspesionSetupR[rightIndex];
+        if(SuspHandleRight.IsValidIndex(rightIndex) && SuspHandleRight[rightIndex])
+        {
+            setupSuspensionUnit(Suspensions, TrackedCore::ETrackSide::Right, setup, SuspHandleRight[rightIndex]);
+        }
+        else
+        {
+            Suspensions.Add(TrackedCore::ETrackSide::Right, toSuspensionUnitSetup(setup, setup.RootLoc, setup.RootRot.Quaternion()));
+        }
 	}
+
+    this->ResizeSuspensionState();
 }
 
-void UTrackedMovementComponent::CalculateCollisions()
+void UTrackedMovementComponent::ResizeSuspensionState()
 {
-    // Right side
-    for(int rIndex = 0; rIndex < SuspensionsInternalRight.Num(); rIndex++)
+    FrictionContacts.Reserve(Suspensions.Num());
+    SuspensionHitComponents.SetNum(Suspensions.Num());
+    ContactCache.Resize(Suspensions.Num());
+    TrackedCore::selectTracedUnits(Suspensions, SimulationLod, LodReducedStride, TracedSuspensionUnits.Units);
+}
+
+TArray<FSuspensionInternalProcessing> UTrackedMovementComponent::GetLeftSuspensions() const
+{
+    TArray<FSuspensionInternalProcessing> result;
+    for(int index = Suspensions.SideBegin(TrackedCore::ETrackSide::Left); index < Suspensions.SideEnd(TrackedCore::ETrackSide::Left); index++)
     {
-        // Instance of suspension processor
-        this->CalculateCollisionForProcessor(SuspensionsInternalRight, rIndex, ESuspensionSide::V_Right);
+        result.Add(makeSuspensionProcessing(Suspensions, ContactCache, index));
     }
+    return result;
+}
 
-    // Left side
-    for(int lIndex = 0; lIndex < SuspensionsInternalLeft.Num(); lIndex++)
+TArray<FSuspensionInternalProcessing> UTrackedMovementComponent::GetRightSuspensions() const
+{
+    TArray<FSuspensionInternalProcessing> result;
+    for(int index = Suspensions.SideBegin(TrackedCore::ETrackSide::Right); index < Suspensions.SideEnd(TrackedCore::ETrackSide::Right); index++)
     {
-        // Instance of suspension processor
-        this->CalculateCollisionForProcessor(SuspensionsInternalLeft, lIndex, ESuspensionSide::V_Left);
+        result.Add(makeSuspensionProcessing(Suspensions, ContactCache, index));
     }
+    return result;
+}
+
+void UTrackedMovementComponent::CalculateCollisions()
+{
+    this->GatherSuspensionTraces();
+    this->ExecuteSuspensionTraces();
+    this->ConsumeSuspensionTraces();
+    this->EvaluateSuspensionForces();
 }
 
-void UTrackedMovementComponent::CalculateCollisionForProcessor(TArray<FSuspensionInternalProcessing>& processors, int index, ESuspensionSide side)
+void UTrackedMovementComponent::GatherSuspensionTraces()
 {
-    // get vehicle actor
-    AActor* actor = this->GetOwner();
+    TRACKED_PHASE_SCOPE(STAT_TrackedGatherTraces, GatherTraces);
 
-    // get vehicle transform
-    FTransform actorTransform = actor->GetTransform();
+    if(Sleep.bAsleep)
+    {
+        SuspensionTraces.Reset(0);
+        return;
+    }
 
-    FSuspensionInternalProcessing suspensionProcessor = processors[index];
+    TrackedCore::gatherSuspensionTraces(Suspensions, Frame, TracedSuspensionUnits.Units, SuspensionTraces);
 
-    // calculate suspension up vector (in world space)
-    //FVector upVector = KismetMathLibrary::TransformDirection(actorTransform, KismetMathLibrary::GetUpVector(processors[index].RootRot));
-    FVector upVector = transformDirection(actorTransform, getUpVector(suspensionProcessor.RootRot));
-    FVector forwardVector = transformDirection(actorTransform, getForwardVector(suspensionProcessor.RootRot));
-    FVector rightVector = transformDirection(actorTransform, getRightVector(suspensionProcessor.RootRot));
-    FVector suspensionWorldLocation = transformLocation(actorTransform, suspensionProcessor.RootLoc);
-    FVector suspensionEndLocation = suspensionWorldLocation + (upVector * -suspensionProcessor.Length);
+    if(this->IsContactReuseActive())
+    {
+        TrackedCore::FContactCacheSettings settings;
+        settings.MaxSegmentMove = ContactReuseDistance;
+        settings.MaxReuseTicks = ContactReuseMaxTicks;
+        ContactCache.Prepare(SuspensionTraces, TracedSuspensionUnits.Units, settings);
+    }
+}
 
-    FHitResult hitResult = FHitResult(ForceInit);
+bool UTrackedMovementComponent::IsContactReuseActive() const
+{
+    // Async sweeps answer a tick late, there is no fresh contact to reuse
+    return ReuseSuspensionContacts && (GroundQuery || !AsyncSuspensionTraces);
+}
 
-    float wheelAngVelocity = side == ESuspensionSide::V_Left ? TrackLeftAngVel : TrackRightAngVel;
-    float wheelLinVelocity = side == ESuspensionSide::V_Left ? TrackLeftLinVel : TrackRightLinVel;
+void UTrackedMovementComponent::ExecuteSuspensionTraces()
+{
+    TRACKED_PHASE_SCOPE(STAT_TrackedExecuteTraces, ExecuteTraces);
 
-    float suspensionNewLength = suspensionProcessor.Length;
-    FVector suspensionForce = FVector();
-    FVector impactPoint = FVector();
-    FVector impactNormal = FVector();
-    bool engaged = false;
-    TEnumAsByte<EPhysicalSurface> hitMaterial = TEnumAsByte<EPhysicalSurface>(EPhysicalSurface::SurfaceType_Default);
+    if(AsyncSuspensionTraces && !GroundQuery)
+    {
+        this->ExecuteAsyncSuspensionTraces();
+        return;
+    }
 
+    // Only the sweeps the contact cache could not answer
+    const bool reuseContacts = this->IsContactReuseActive();
+    TrackedCore::FSweepBatch& sweeps = reuseContacts ? ContactCache.PendingSweeps : SuspensionTraces;
+    const int count = sweeps.Num();
+    TRACKED_COUNTER(STAT_TrackedTraces, Traces, count);
 
-    if(TraceForSuspension(suspensionWorldLocation, suspensionEndLocation, suspensionProcessor.Radius, hitResult))
+    // Custom backend (heightfield, headless stand-in) knows nothing about components
+    if(GroundQuery)
     {
-        suspensionNewLength = FVector::Distance(suspensionWorldLocation, hitResult.Location);
-        impactPoint = hitResult.ImpactPoint;
-        impactNormal = hitResult.ImpactNormal;
-        engaged = true;
+        GroundQuery->SweepBatch(sweeps);
+        for(int sweep = 0; sweep < count; sweep++)
+        {
+            const int trace = reuseContacts ? ContactCache.PendingTraces[sweep] : sweep;
+            SuspensionHitComponents[TracedSuspensionUnits[trace]] = nullptr;
+        }
+    }
+    else
+    {
+        for(int sweep = 0; sweep < count; sweep++)
+        {
+            const TrackedCore::FSweepRequest& request = sweeps.Requests[sweep];
+            const int trace = reuseContacts ? ContactCache.PendingTraces[sweep] : sweep;
+            FHitResult hitResult = FHitResult(ForceInit);
+
+            TraceForSuspension(toEngine(request.Start), toEngine(request.End), request.Radius, hitResult);
 
-        if(hitResult.PhysMaterial.IsValid()) {
-            UPhysicalMaterial* physicalMaterial = hitResult.PhysMaterial.Get();
-            hitMaterial = physicalMaterial->SurfaceType;
+            toSweepHit(hitResult, sweeps.Hits[sweep]);
+            SuspensionHitComponents[TracedSuspensionUnits[trace]] = hitResult.Component;
+
+            if(reuseContacts)
+            {
+                ContactCache.PendingCacheable[sweep] = isStaticContact(hitResult.Component.Get()) ? 1 : 0;
+            }
         }
+    }
 
+    if(reuseContacts)
+    {
+        ContactCache.Resolve(SuspensionTraces, TracedSuspensionUnits.Units);
+    }
+}
 
-        // Calculate suspension force:
+void UTrackedMovementComponent::ExecuteAsyncSuspensionTraces()
+{
+    UWorld* world = GetWorld();
+    const int count = SuspensionTraces.Num();
 
-        // rate and stiffness
-        float compressionRate = FMath::Clamp((suspensionProcessor.Length - suspensionNewLength) / suspensionProcessor.Length, 0.0f, 1.0f);
-        float compressionStiffness = compressionRate * suspensionProcessor.Stiffness;
-        // calculate susp velocity
-        float suspensionVelocity = (suspensionNewLength - suspensionProcessor.PreviousLenght) / DT;
-        suspensionVelocity = suspensionProcessor.Damping * (SuspTargetVelocity - suspensionVelocity);
+    SuspensionTraceHandles.SetNum(count);
+    TRACKED_COUNTER(STAT_TrackedTraces, Traces, count);
 
-        float suspensionForceMagnitude = compressionRate * compressionStiffness + suspensionVelocity;
+    for(int index = 0; index < count; index++)
+    {
+        const TrackedCore::FSweepRequest& request = SuspensionTraces.Requests[index];
+        TrackedCore::FSweepHit& hit = SuspensionTraces.Hits[index];
 
-        suspensionForce = upVector * suspensionForceMagnitude;
+        // Consume the sweep submitted on the previous tick
+        hit.bHit = false;
+        SuspensionHitComponents[TracedSuspensionUnits[index]] = nullptr;
 
-        // TODO: Add force to mesh!
-        if(UpdatedPrimitive->IsSimulatingPhysics(NAME_None)) {
-            UpdatedPrimitive->AddForceAtLocation(suspensionForce, suspensionWorldLocation, NAME_None);
+        FTraceDatum traceDatum;
+        if(SuspensionTraceHandles[index].IsValid() && world->QueryTraceData(SuspensionTraceHandles[index], traceDatum) && traceDatum.OutHits.Num() > 0)
+        {
+            const FHitResult& hitResult = traceDatum.OutHits[0];
+            toSweepHit(hitResult, hit);
+            SuspensionHitComponents[TracedSuspensionUnits[index]] = hitResult.Component;
+
+            // Carry the contact along with the suspension root moved since submission
+            TrackedCore::FVec3 rootDelta = request.Start - toCore(traceDatum.Start);
+            hit.Location += rootDelta;
+            hit.ImpactPoint += rootDelta;
         }
-//        body.AddForceAtLocation(suspensionForce, suspensionWorldLocation);
 
-        if(hitResult.Component.IsValid()) {
-            UPrimitiveComponent* component = hitResult.Component.Get();
-            if(component->IsSimulatingPhysics(NAME_None)) {
-                component->AddForceAtLocation(-suspensionForce, impactPoint, NAME_None);
-            }
-        }
+        // Submit the sweep for the next tick
+        SuspensionTraceHandles[index] = world->AsyncSweepByChannel(
+                EAsyncTraceType::Single,
+                toEngine(request.Start),
+                toEngine(request.End),
+                SuspensionTraceChannel,
+                FCollisionShape::MakeSphere(request.Radius),
+                SuspensionQueryParams);
+    }
+}
+
+void UTrackedMovementComponent::ConsumeSuspensionTraces()
+{
+    TRACKED_PHASE_SCOPE(STAT_TrackedConsumeTraces, ConsumeTraces);
 
-        TotalNumFrictionPoints++;
+    if(Sleep.bAsleep)
+    {
+        return;
     }
 
+    TotalNumFrictionPoints = TrackedCore::consumeSuspensionTraces(Suspensions, SuspensionTraces, TracedSuspensionUnits.Units, *ActiveSurfaceTable);
+    TRACKED_COUNTER(STAT_TrackedEngagedContacts, EngagedContacts, (int64)TotalNumFrictionPoints);
 
-    // Update Processor
-    processors[index].PreviousLenght = suspensionNewLength;
-    processors[index].SuspensionForce = suspensionForce;
-    processors[index].WheelCollisionLocation = impactPoint;
-    processors[index].WheelCollisionNormal = impactNormal;
-    processors[index].Engaged = engaged;
-    processors[index].HitMaterial = hitMaterial;
+    if(SuspensionTraces.Num() < Suspensions.Num())
+    {
+        // Interpolated units (the gaps between traced ones) push on nothing
+        for(int traced = 0; traced + 1 < TracedSuspensionUnits.Num(); traced++)
+        {
+            for(int index = TracedSuspensionUnits[traced] + 1; index < TracedSuspensionUnits[traced + 1]; index++)
+            {
+                SuspensionHitComponents[index] = nullptr;
+            }
+        }
+    }
 }
 
-
-bool UTrackedMovementComponent::TraceForSuspension(const FVector& start, const FVector& end, float radius, FHitResult& outResult)
+void UTrackedMovementComponent::EvaluateSuspensionForces()
 {
-    return VTraceSphere(nullptr, start, end, radius, outResult);
+    TRACKED_PHASE_SCOPE(STAT_TrackedSuspensionForces, SuspensionForces);
+
+    if(Sleep.bAsleep)
+    {
+        return;
+    }
+
+    TrackedCore::evaluateSuspensionForces(Suspensions, SimulationLod, SuspTargetVelocity, DT, BodyForces);
 }
 
-void UTrackedMovementComponent::ApplyDriveForceAndGetFrictionForceOnSide(
-        TArray<FSuspensionInternalProcessing>& processors,
-        const FVector& driveForceSide,
-        float trackLinVelSide)
+void UTrackedMovementComponent::ApplyAccumulatedForces()
 {
-    AActor* actor = movementComponent->GetOwner();
-    FTransform actorTransform = actor->GetTransform();
-    FVector forwardVector = getForwardVector(actorTransform.Rotator());
-    FVector rightVector = getRightVector(actorTransform.Rotator());
-
-    FVector linearForwardVelocity = forwardVector * trackLinVelSide;
+    TRACKED_PHASE_SCOPE(STAT_TrackedApplyForces, ApplyForces);
 
-    UPrimitiveComponent* primitiveComponent = UpdatedPrimitive;
+    if(Sleep.bAsleep || SimulationLod == TrackedCore::ESimulationLod::Kinematic)
+    {
+        return;
+    }
 
-    float bodyMass = primitiveComponent->GetMass();
+    int forcesApplied = 0;
+    if(!BodyForces.IsEmpty() && UpdatedPrimitive->IsSimulatingPhysics(NAME_None)) {
+        UpdatedPrimitive->AddForce(toEngine(BodyForces.Force), NAME_None);
+        UpdatedPrimitive->AddTorque(toEngine(BodyForces.Torque), NAME_None);
+        forcesApplied++;
+    }
 
-    // Loop over suspension processors
-    for(int processorIndex = 0; processorIndex < processors.Num(); processorIndex++)
+    // Group suspension reactions by the body they push on
+    ReactionForces.Reset();
+    for(int index = 0; index < Suspensions.Num(); index++)
     {
-        FSuspensionInternalProcessing suspension = processors[processorIndex];
-        // Only with engaged suspensions!
-        if(suspension.Engaged)
-        {
-            float wheelLoadN = projectVectorOnToVector(suspension.SuspensionForce, suspension.WheelCollisionNormal).Size();
-            FVector velocityAtPont = getVelocityAtLocation(this, suspension.WheelCollisionLocation);
-            FVector relativeTrackVelocity = projectVectorToPlane(velocityAtPont - linearForwardVelocity, suspension.WheelCollisionNormal);
+        UPrimitiveComponent* component = SuspensionHitComponents[index].Get();
+        if(!Suspensions.Engaged[index] || !component) {
+            continue;
+        }
+
+        FReactionForces* reaction = ReactionForces.FindByPredicate([component](const FReactionForces& item) {
+            return item.Component.Get() == component;
+        });
+        if(!reaction) {
+            if(!component->IsSimulatingPhysics(NAME_None)) {
+                continue;
+            }
+            reaction = &ReactionForces[ReactionForces.AddDefaulted()];
+            reaction->Component = component;
+            reaction->Forces.Reset(toCore(component->GetCenterOfMass(NAME_None)));
+        }
 
-            FVector2D Mu = getMuFromFrictionElipse(relativeTrackVelocity.GetSafeNormal(), forwardVector, MuXStatic, MuYStatic, MuXKinetic, MuYKinetic);
-            float muStatic = Mu.X;
-            float muKinetic = Mu.Y;
+        reaction->Forces.AddForceAtLocation(-Suspensions.Force[index], Suspensions.ContactPoint[index]);
+    }
 
-            FVector velocityMultiplied = -relativeTrackVelocity * bodyMass / DT / TotalNumFrictionPoints;
+    for(const FReactionForces& reaction : ReactionForces)
+    {
+        UPrimitiveComponent* component = reaction.Component.Get();
+        component->AddForce(toEngine(reaction.Forces.Force), NAME_None);
+        component->AddTorque(toEngine(reaction.Forces.Torque), NAME_None);
+        forcesApplied++;
+    }
 
-            FVector projectedNormalizedForward = projectVectorToPlane(forwardVector, suspension.WheelCollisionNormal).Normalize();
-            FVector projectedNormalizedRight   = projectVectorToPlane(rightVector,   suspension.WheelCollisionNormal).Normalize();
+    TRACKED_COUNTER(STAT_TrackedForcesApplied, ForcesApplied, forcesApplied);
+}
 
-            FVector projectedVelocityOnForward = projectVectorOnToVector(velocityMultiplied, projectedNormalizedForward);
-            FVector projectedVelocityOnRight   = projectVectorOnToVector(velocityMultiplied, projectedNormalizedRight);
+void UTrackedMovementComponent::FollowGroundKinematic()
+{
+    TRACKED_PHASE_SCOPE(STAT_TrackedGroundFollow, GroundFollow);
 
-            FVector fullStaticFrictionForce = projectedVelocityOnForward * MuXStatic + projectedVelocityOnRight * MuYStatic;
-            FVector fullKineticFrictionForce = projectedVelocityOnForward * MuXKinetic + projectedVelocityOnRight * MuYKinetic;
+    if(Sleep.bAsleep || SimulationLod != TrackedCore::ESimulationLod::Kinematic)
+    {
+        return;
+    }
 
-            FVector projectedDriveForceSide = projectVectorToPlane(driveForceSide, suspension.WheelCollisionNormal);
+    AActor* owner = GetOwner();
 
-            FVector fullStaticDriveForce = projectedDriveForceSide * MuXStatic;
-            FVector fullKineticDriveForce = projectedDriveForceSide * MuXKinetic;
+    // Left track faster than the right one turns to the right (positive yaw)
+    const float trackWidth = TrackedCore::calculateTrackWidth(Suspensions);
+    const float yawRate = trackWidth > TrackedCore::Epsilon ? (TrackLeftLinVel - TrackRightLinVel) / trackWidth : 0.0f;
 
-            // We want to apply higher friction if forces are bellow static friction limit
-            if((fullStaticFrictionForce + fullStaticDriveForce).Size() >= wheelLoadN * muStatic) {
+    FVector locationDelta = toEngine(Frame.LinearVelocity) * DT;
+    FRotator rotationDelta(0.0f, FMath::RadiansToDegrees(yawRate * DT), 0.0f);
 
-            }
-        }
+    // Without ground under the corners the hull keeps its height and attitude
+    TrackedCore::FGroundFollow groundFollow = TrackedCore::fitGroundFollow(Suspensions, KinematicRideRatio);
+    if(groundFollow.bValid)
+    {
+        locationDelta += toEngine(Frame.Up) * groundFollow.HeightOffset;
+        // Pitch up raises the nose, roll up lowers the right side
+        rotationDelta.Pitch = FMath::RadiansToDegrees(groundFollow.PitchAngle);
+        rotationDelta.Roll = -FMath::RadiansToDegrees(groundFollow.RollAngle);
     }
+
+    owner->SetActorLocationAndRotation(
+            owner->GetActorLocation() + locationDelta,
+            owner->GetActorQuat() * rotationDelta.Quaternion(),
+            false,
+            nullptr,
+            ETeleportType::TeleportPhysics);
+}
+
+
+bool UTrackedMovementComponent::TraceForSuspension(const FVector& start, const FVector& end, float radius, FHitResult& outResult)
+{
+    return GetWorld()->SweepSingleByChannel(
+            outResult,
+            start,
+            end,
+            FQuat::Identity,
+            SuspensionTraceChannel,
+            FCollisionShape::MakeSphere(radius),
+            SuspensionQueryParams);
+}
+
+void UTrackedMovementComponent::SetGroundQuery(TrackedCore::IGroundQuery* groundQuery)
+{
+    GroundQuery = groundQuery;
+    ContactCache.InvalidateAll();
 }
 
 void UTrackedMovementComponent::ApplyDriveForcesAndGetFrictionForcesOnSides()
 {
-    //Right side
+    TRACKED_PHASE_SCOPE(STAT_TrackedFriction, Friction);
+
+    if(Sleep.bAsleep)
+    {
+        return;
+    }
+
+    DriveRightForce = toEngine(Frame.Forward) * DriveRightTorque / SprocketRadiusCm;
+    DriveLeftForce = toEngine(Frame.Forward) * DriveLeftTorque / SprocketRadiusCm;
 
-    // Left side
-}
\ No newline at end of file
+    TrackedCore::FDrivetrainParams params;
+    this->MakeDrivetrainParams(params);
+
+    TrackedCore::FTrackFrictionParams friction;
+    friction.Surfaces = ActiveSurfaceTable;
+    friction.SprocketRadiusCm = SprocketRadiusCm;
+
+    // A Kinematic hull gets no-slip torques, otherwise every engaged contact is solved and pushes on BodyForces
+    TrackedCore::FDrivetrainState state;
+    this->ReadDrivetrainState(state);
+    TrackedCore::updateTrackFriction(state, params, SimulationLod, Suspensions, Frame, friction, GravityCm, DT, FrictionContacts, BodyForces);
+    this->WriteDrivetrainState(state);
+}
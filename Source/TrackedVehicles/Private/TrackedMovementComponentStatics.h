@@ -1,183 +1,237 @@
 #pragma once
 
-const float M2CM = 100.0f;
-const float EPSILON = 0.000001f;
+// Engine side helpers of the movement component, inline so any source of the module may include them
 
-// fsign function to get sign part of numeric types
-template <typename T> int fsign(T val)
+#include "Core/TrackedContactCache.h"
+#include "Core/TrackedCurveTable.h"
+#include "Core/TrackedDrivetrain.h"
+#include "Core/TrackedGroundQuery.h"
+#include "Core/TrackedSurfaceTable.h"
+#include "Core/TrackedSuspension.h"
+#include "Core/TrackedSuspensionStore.h"
+#include "Core/TrackedVehicleFrame.h"
+#include "TrackedVehicles.h"
+
+FORCEINLINE TrackedCore::FVec3 toCore(const FVector& v)
 {
-    return (T(0) < val) - (val < T(0));
+    return TrackedCore::FVec3(v.X, v.Y, v.Z);
 }
 
-bool VTraceSphere(
-        AActor* ActorToIgnore,
-        const FVector& Start,
-        const FVector& End,
-        const float Radius,
-        FHitResult& HitOut,
-        ECollisionChannel TraceChannel=ECC_Pawn
-) {
-    FCollisionQueryParams TraceParams(FName(TEXT("VictoreCore Trace")), true, ActorToIgnore);
-    TraceParams.bTraceComplex = true;
-    TraceParams.bReturnPhysicalMaterial = true;
-
-    //Ignore Actors
-    TraceParams.AddIgnoredActor(ActorToIgnore);
+FORCEINLINE FVector toEngine(const TrackedCore::FVec3& v)
+{
+    return FVector(v.X, v.Y, v.Z);
+}
 
-    //Re-initialize hit info
-//    HitOut = FHitResult(ForceInit);
+// Query params shared by every suspension sweep of a vehicle, built once per component
+inline FCollisionQueryParams makeSuspensionQueryParams(const AActor* owner)
+{
+    static const FName SuspensionTraceTag(TEXT("TrackedSuspensionTrace"));
 
-    //Get World Source
-    TObjectIterator<APlayerController> ThePC;
-    if(!ThePC) return false;
+    FCollisionQueryParams traceParams(SuspensionTraceTag, true, owner);
+    traceParams.bTraceComplex = true;
+    traceParams.bReturnPhysicalMaterial = true;
+    return traceParams;
+}
 
+inline void toSweepHit(const FHitResult& hitResult, TrackedCore::FSweepHit& outHit)
+{
+    outHit.bHit = hitResult.bBlockingHit;
+    outHit.Location = toCore(hitResult.Location);
+    outHit.ImpactPoint = toCore(hitResult.ImpactPoint);
+    outHit.ImpactNormal = toCore(hitResult.ImpactNormal);
+    outHit.SurfaceType = EPhysicalSurface::SurfaceType_Default;
 
-    return ThePC->GetWorld()->SweepSingleByChannel(
-            HitOut,         // struct FHitResult& OutHit,
-            Start,          // const FVector& Start,
-            End,            // const FVector& End,
-            FQuat(),        // const FQuat& Rot,
-            TraceChannel,   // ECollisionChannel TraceChannel,
-            FCollisionShape::MakeSphere(Radius), // const FCollisionShape& CollisionShape,
-            TraceParams);
-//            const FCollisionQueryParams& Params = FCollisionQueryParams::DefaultQueryParam,
-//            const FCollisionResponseParams& ResponseParam = FCollisionResponseParams::DefaultResponseParam) const;
+    if(hitResult.PhysMaterial.IsValid()) {
+        outHit.SurfaceType = hitResult.PhysMaterial.Get()->SurfaceType;
+    }
 }
 
-FVector getUpVector(const FRotator& inRot)
+// Contacts on geometry that cannot move may be reused by the contact cache
+inline bool isStaticContact(const UPrimitiveComponent* component)
 {
-    return FRotationMatrix(inRot).GetScaledAxis(EAxis::Z);
+    return component && component->Mobility != EComponentMobility::Movable && !component->IsSimulatingPhysics(NAME_None);
 }
-FVector getForwardVector(const FRotator& inRot)
-{
-    return FRotationMatrix(inRot).GetScaledAxis(EAxis::X);
+
+inline TrackedCore::FSuspensionUnitSetup toSuspensionUnitSetup(const FSuspensionSetup& setup, const FVector& rootLocation, const FQuat& rootRotation) {
+    TrackedCore::FSuspensionUnitSetup unit;
+    unit.RootLocation = toCore(rootLocation);
+    unit.RootRotation = TrackedCore::FQuat4(rootRotation.X, rootRotation.Y, rootRotation.Z, rootRotation.W);
+    unit.Length = setup.MaximumLenght;
+    unit.Radius = setup.CollisionRadius;
+    unit.Stiffness = setup.StiffnessForce;
+    unit.Damping = setup.DampingForce;
+    return unit;
 }
-FVector getRightVector(const FRotator& inRot)
-{
-    return FRotationMatrix(inRot).GetScaledAxis(EAxis::Y);
+
+inline void setupSuspensionUnit(TrackedCore::FSuspensionStore& store, TrackedCore::ETrackSide side, const FSuspensionSetup& setup, UStaticMeshComponent* handler) {
+    FTransform handlerRelativeTransform = handler->GetRelativeTransform();
+    store.Add(side, toSuspensionUnitSetup(setup, handlerRelativeTransform.GetLocation(), handlerRelativeTransform.GetRotation()));
+};
+
+// Blueprint view of a single unit of the suspension store
+inline FSuspensionInternalProcessing makeSuspensionProcessing(const TrackedCore::FSuspensionStore& store, const TrackedCore::FContactCache& contactCache, int index) {
+    const TrackedCore::FQuat4& rootRotation = store.RootRotation[index];
+
+    FSuspensionInternalProcessing processing = FSuspensionInternalProcessing::Make(
+            toEngine(store.RootLocation[index]),
+            FRotator(FQuat(rootRotation.X, rootRotation.Y, rootRotation.Z, rootRotation.W)),
+            store.Length[index],
+            store.Radius[index],
+            store.Stiffness[index],
+            store.Damping[index]);
+
+    processing.PreviousLenght = store.PreviousLength[index];
+    processing.SuspensionForce = toEngine(store.Force[index]);
+    processing.WheelCollisionLocation = toEngine(store.ContactPoint[index]);
+    processing.WheelCollisionNormal = toEngine(store.ContactNormal[index]);
+    processing.Engaged = store.Engaged[index] != 0;
+    processing.HitMaterial = TEnumAsByte<EPhysicalSurface>((EPhysicalSurface)store.HitMaterial[index]);
+    processing.ContactReused = index < contactCache.Num() && contactCache.Reused[index] != 0;
+
+    return processing;
 }
 
-FVector transformDirection(const FTransform& transform, const FVector& direction)
+inline float clampEngineRPM(float engineRPM, UCurveFloat* curve)
 {
-    return transform.TransformVectorNoScale(direction);
+    check(curve);
+    float minTime;
+    float maxTime;
+    curve->GetTimeRange(minTime, maxTime);
+    return FMath::Clamp(engineRPM, minTime, maxTime);
 }
-FVector transformLocation(const FTransform& transform, const FVector& location)
+
+inline float calculateEngineTorque(float engineRPM, UCurveFloat* curve)
 {
-    return transform.TransformPosition(location);
+    // get value from curve and convert from meters to cm
+    check(curve);
+    return curve->GetFloatValue(engineRPM) * TrackedCore::M2CM;
 }
 
-FVector inverseTransformDirection(const FTransform& transform, const FVector& direction)
+// Unbaked torque curve, sampled by TrackedCore::updateEngineAndDrive like a baked table
+struct FEngineTorqueCurve
 {
-    return transform.InverseTransformPosition(direction);
+    UCurveFloat* Curve;
+
+    float Clamp(float engineRPM) const { return clampEngineRPM(engineRPM, Curve); }
+    float Evaluate(float engineRPM) const { return calculateEngineTorque(engineRPM, Curve); }
+};
+
+// Bake the torque curve (already converted to cm) and report how far the table is from the curve
+inline TrackedCore::FCurveTableAccuracy bakeEngineTorqueTable(UCurveFloat* curve, int numSamples, TrackedCore::FCurveTable& outTable)
+{
+    check(curve);
+    float minTime;
+    float maxTime;
+    curve->GetTimeRange(minTime, maxTime);
+
+    auto torqueAtRPM = [curve](float engineRPM) { return calculateEngineTorque(engineRPM, curve); };
+    outTable.Build(minTime, maxTime, numSamples, torqueAtRPM);
+
+    // Check between the baked samples too, that is where interpolation error peaks
+    return TrackedCore::measureCurveTableAccuracy(outTable, torqueAtRPM, numSamples * 8);
 }
-FVector inverseTransformLocation(const FTransform& transform, const FVector& location)
+
+inline TrackedCore::FSurfaceParams toSurfaceParams(const FTrackSurfaceSetup& setup)
 {
-    return transform.InverseTransformPosition(location);
+    TrackedCore::FSurfaceParams params;
+    params.MuXStatic = setup.Mu_X_Static;
+    params.MuYStatic = setup.Mu_Y_Static;
+    params.MuXKinetic = setup.Mu_X_Kinetic;
+    params.MuYKinetic = setup.Mu_Y_Kinetic;
+    params.RollingFrictionCoef = setup.RollingFrictionCoef;
+    params.SinkDepth = setup.SinkDepth;
+    return params;
 }
 
-FVector projectVectorOnToVector(FVector V, FVector Target)
+inline void buildSurfaceTable(const TrackedCore::FSurfaceParams& defaults, const TArray<FTrackSurfaceSetup>& setups, TrackedCore::FSurfaceTable& outTable)
 {
-    if (Target.SizeSquared() > SMALL_NUMBER)
-    {
-        return V.ProjectOnTo(Target);
-    }
-    else
+    outTable.Fill(defaults);
+    for(const FTrackSurfaceSetup& setup : setups)
     {
-        ReportError_ProjectVectorOnToVector();
-        return FVector::ZeroVector;
+        outTable.Set((uint8)setup.Surface.GetValue(), toSurfaceParams(setup));
     }
 }
 
-FVector projectVectorToPlane(FVector V, FVector PlaneNormal)
+// Tables derived from the tuning properties, built by UTrackedVehicleClass and by a component without one.
+// TuningType is either of them, both name the properties the same
+
+template <typename TuningType>
+void buildSurfaceTable(const TuningType& tuning, TrackedCore::FSurfaceTable& outTable)
 {
-    return FVector::VectorPlaneProject(V, PlaneNormal);
+    TrackedCore::FSurfaceParams defaults;
+    defaults.MuXStatic = tuning.Mu_X_Static;
+    defaults.MuYStatic = tuning.Mu_Y_Static;
+    defaults.MuXKinetic = tuning.Mu_X_Kinetic;
+    defaults.MuYKinetic = tuning.Mu_Y_Kinetic;
+    defaults.RollingFrictionCoef = tuning.RollingFrictionCoef;
+
+    buildSurfaceTable(defaults, tuning.SurfaceSetup, outTable);
 }
 
+template <typename TuningType>
+void bakeEngineTorqueTable(const TuningType& tuning, TrackedCore::FCurveTable& outTable)
+{
+    outTable.Reset();
+    if(!tuning.EngineTorqueCurve)
+    {
+        return;
+    }
 
-void setupSuspensionHandlersArray(TArray<FSuspensionInternalProcessing>* dest, const FSuspensionSetup& setup, UStaticMeshComponent* handler) {
-    FTransform handlerRelativeTransform = handler->GetRelativeTransform();
-    // TODO: possible GC issue (fiqure out proper way to create USTRUCTs)
-    dest->Add(FSuspensionInternalProcessing::Make(
-            handlerRelativeTransform.GetLocation(), // RootLoc
-            handlerRelativeTransform.Rotator(),		// RootRot
-            setup.MaximumLenght,		// Lenght
-            setup.CollisionRadius,		// Radius
-            setup.StiffnessForce,		// Stiffness
-            setup.DampingForce		    // Damping
-//            0.0f,						// PreviousLenght
-//            FVector(),					// SuspensionForce
-//            FVector(),					// WheelCollisionLocation
-//            FVector(),					// WheelCollisionNormal
-//            false,						// Engaged
-//            TEnumAsByte<EPhysicalSurface>(EPhysicalSurface::SurfaceType_Default) // HitMaterial
-    ));
-};
+    TrackedCore::FCurveTableAccuracy accuracy = bakeEngineTorqueTable(tuning.EngineTorqueCurve, tuning.EngineTorqueTableSamples, outTable);
 
-float calculateInertia(float angVel, float torque, float inertia, float dt) {
-    return angVel + (torque / inertia) * dt;
+    UE_LOG(LogTrackedVehicles, Log, TEXT("%s: baked %s into %d samples, max error %f at %f RPM, rms error %f"),
+           *tuning.GetPathName(), *tuning.EngineTorqueCurve->GetName(), tuning.EngineTorqueTableSamples,
+           accuracy.MaxAbsError, accuracy.MaxErrorTime, accuracy.RmsError);
 }
 
-float calculateBrake(float angVelIn, float brakeRatio, float brakeForce, float dt)
+// Shift points from the baked torque table, from the curve itself when it is not baked
+template <typename TuningType>
+void buildGearbox(const TuningType& tuning, const TrackedCore::FCurveTable& torqueTable, TrackedCore::FGearbox& outGearbox)
 {
-    float brakeCoef = brakeRatio * brakeForce * dt;
-    if(fabs(angVelIn) > fabs(brakeCoef))
+    UCurveFloat* curve = tuning.EngineTorqueCurve;
+
+    float minRPM = 0.0f;
+    float maxRPM = 0.0f;
+    if(torqueTable.IsValid())
     {
-        return angVelIn - (brakeCoef * fsign(angVelIn));
+        minRPM = torqueTable.MinTime;
+        maxRPM = torqueTable.MaxTime;
     }
-    else
+    else if(curve)
     {
-        return angVelIn;
+        curve->GetTimeRange(minRPM, maxRPM);
     }
-}
 
-float calculateEngineRPM(float angVel, float gearRation, float diferentialRatio)
-{
-    // TODO Move magic number to constants
-    return (angVel * gearRation * diferentialRatio * 60) / (PI * 2);
-}
+    TrackedCore::FGearboxSettings settings;
+    settings.UpShiftPrc = tuning.GearUpShiftPrc;
+    settings.DownShiftPrc = tuning.GearDownShiftPrc;
+    settings.ShiftDelay = tuning.GearShiftDelay;
 
-float clampEngineRPM(float engineRPM, UCurveFloat* curve)
-{
-    check(curve);
-    float minTime;
-    float maxTime;
-    curve->GetTimeRange(minTime, maxTime);
-    return FMath::Clamp(engineRPM, minTime, maxTime);
-}
+    outGearbox.Build(tuning.GearRatios.GetData(), tuning.GearRatios.Num(), tuning.DiferentialRatio, minRPM, maxRPM, settings);
 
-float calculateEngineTorque(float engineRPM, UCurveFloat* curve)
-{
-    // get value from curve and convert from meters to cm
-    check(curve);
-    return curve->GetFloatValue(engineRPM) * M2CM;
+    // Place the up shifts where the next gear pulls harder, the RPM fractions stay as the fallback
+    if(torqueTable.IsValid())
+    {
+        outGearbox.BuildShiftTable(tuning.DiferentialRatio, minRPM, maxRPM, [&torqueTable](float engineRPM) { return torqueTable.Evaluate(engineRPM); });
+    }
+    else if(curve)
+    {
+        outGearbox.BuildShiftTable(tuning.DiferentialRatio, minRPM, maxRPM, [curve](float engineRPM) { return calculateEngineTorque(engineRPM, curve); });
+    }
 }
 
-VFector getVelocityAtLocation(const UMovementComponent* movementComponent, const FVector& location)
+inline void captureVehicleFrame(const AActor* actor, UPrimitiveComponent* body, TrackedCore::FVehicleFrame& outFrame)
 {
-    // get vehicle actor
-    AActor* actor = movementComponent->GetOwner();
-    UPrimitiveComponent* body = movementComponent->UpdatedPrimitive;
-    FTransform actorTransform = actor->GetTransform();
+    const FTransform& actorTransform = actor->GetTransform();
+    FQuat rotation = actorTransform.GetRotation();
 
-    FVector linearVelocity = body->GetPhysicsLinearVelocity(NAME_None);
-    FVector angularVelocity = body->GetPhysicsAngularVelocity(NAME_None);
-    FVector centerOfMass = body->GetCenterOfMass(NAME_None);
+    outFrame.Location = toCore(actorTransform.GetLocation());
+    outFrame.Rotation = TrackedCore::FQuat4(rotation.X, rotation.Y, rotation.Z, rotation.W);
+    outFrame.Scale = toCore(actorTransform.GetScale3D());
+    outFrame.UpdateBasis();
 
-    FVector localLinearVelocity = inverseTransformDirection(actorTransform, linearVelocity);
-    FVector localAngularVelocity = inverseTransformDirection(actorTransform, angularVelocity) * 0.0174532925; // To radians
-    FVector localCenterOfMass = inverseTransformLocation(actorTransform, centerOfMass);
-    FVector localLocation = inverseTransformLocation(actorTransform, location);
-
-    FVector difference = localCenterOfMass - localLocation;
-    FVector differenceAngularCross = FVector::CrossProduct(localAngularVelocity, difference);
-    FVector sumLinearAndAngular = differenceAngularCross + localLinearVelocity;
-
-    return transformDirection(sumLinearAndAngular);
+    outFrame.LinearVelocity = toCore(body->GetPhysicsLinearVelocity(NAME_None));
+    outFrame.AngularVelocity = toCore(body->GetPhysicsAngularVelocity(NAME_None)) * TrackedCore::DegToRad;
+    outFrame.CenterOfMass = toCore(body->GetCenterOfMass(NAME_None));
+    outFrame.Mass = body->GetMass();
 }
-
-FVector2D getMuFromFrictionElipse(FVector velocityDirection, FVector forwardVector, float muXStatic, float muYStatic, float muXKinetic, float muYKinetic)
-{
-    float dot = FVector::DotProduct(velocityDirection, forwardVector);
-    float negateSqrtSquare = fsqrt(1 - dot * dot);
-    return FVector2D(FVector2D(muXStatic * dot, muYStatic * negateSqrtSquare).Size(), FVector2D(muXKinetic* dot, muYKinetic* negateSqrtSquare).Size());
-}
\ No newline at end of file
@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "TrackedReplicatedState.h"
+#include "TrackedVehicles.h"
+
+namespace
+{
+    // Larger payloads are corrupt, a full snapshot of 63 units stays well under it
+    const uint32 MaxSnapshotBits = 4096;
+
+    // Snapshot a connection received, the baseline of the next delta to it
+    class FTrackedNetBaseState : public INetDeltaBaseState
+    {
+    public:
+        explicit FTrackedNetBaseState(const TrackedCore::FVehicleNetSnapshot& snapshot)
+            : Snapshot(snapshot)
+        {
+        }
+
+        virtual bool IsStateEqual(INetDeltaBaseState* OtherState) override
+        {
+            return Snapshot.IsStateEqual(static_cast<FTrackedNetBaseState*>(OtherState)->Snapshot);
+        }
+
+        TrackedCore::FVehicleNetSnapshot Snapshot;
+    };
+}
+
+bool FTrackedNetInput::NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess)
+{
+    uint8 left = TrackedCore::quantizeNetInput(Left);
+    uint8 right = TrackedCore::quantizeNetInput(Right);
+
+    Ar << Sequence;
+    Ar << left;
+    Ar << right;
+
+    if(Ar.IsLoading())
+    {
+        Left = TrackedCore::dequantizeNetInput(left);
+        Right = TrackedCore::dequantizeNetInput(right);
+    }
+
+    bOutSuccess = true;
+    return true;
+}
+
+void FTrackedReplicatedState::Reset()
+{
+    const uint16 sequence = Latest.Sequence;
+    Latest = TrackedCore::FVehicleNetSnapshot();
+    Latest.Sequence = sequence;
+    Received.Reset();
+}
+
+bool FTrackedReplicatedState::NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+{
+    if(DeltaParms.Writer)
+    {
+        const FTrackedNetBaseState* oldState = static_cast<const FTrackedNetBaseState*>(DeltaParms.OldState);
+        if(oldState && oldState->Snapshot.IsStateEqual(Latest))
+        {
+            return false;
+        }
+
+        const bool delta = oldState && !TrackedCore::needsFullNetSnapshot(Latest.Sequence, oldState->Snapshot.Sequence);
+
+        Writer.Reset();
+        TrackedCore::writeNetSnapshot(Writer, Latest, delta ? &oldState->Snapshot : nullptr, Quantization);
+
+        uint32 numBits = (uint32)Writer.GetNumBits();
+        DeltaParms.Writer->SerializeIntPacked(numBits);
+        DeltaParms.Writer->SerializeBits(const_cast<uint8*>(Writer.GetBytes().data()), numBits);
+
+        *DeltaParms.NewState = MakeShareable(new FTrackedNetBaseState(Latest));
+        return true;
+    }
+
+    if(DeltaParms.Reader)
+    {
+        uint32 numBits = 0;
+        DeltaParms.Reader->SerializeIntPacked(numBits);
+        if(numBits > MaxSnapshotBits)
+        {
+            DeltaParms.Reader->SetError();
+            return false;
+        }
+
+        ReadBuffer.SetNumZeroed((numBits + 7) / 8);
+        DeltaParms.Reader->SerializeBits(ReadBuffer.GetData(), numBits);
+
+        // A delta against a snapshot this client never got is dropped, the next full one recovers.
+        // The bits are consumed, so the bunch stays valid and the connection open
+        TrackedCore::FNetBitReader reader(ReadBuffer.GetData(), (int)numBits);
+        switch(TrackedCore::readNetSnapshot(reader, Received, Quantization, Decoded))
+        {
+        case TrackedCore::ENetSnapshotRead::MissingBaseline:
+            UE_LOG(LogTrackedVehicles, Verbose, TEXT("Dropped vehicle snapshot without its baseline"));
+            return true;
+        case TrackedCore::ENetSnapshotRead::Corrupt:
+            DeltaParms.Reader->SetError();
+            return false;
+        default:
+            break;
+        }
+
+        // Late snapshots can still be baselines, but must not roll back a state still in the history
+        Received.Add(Decoded);
+        if(!TrackedCore::isNewerSequence(Decoded.Sequence, Latest.Sequence) && Received.Find(Latest.Sequence))
+        {
+            UE_LOG(LogTrackedVehicles, Verbose, TEXT("Kept vehicle snapshot %d over the late %d"), Latest.Sequence, Decoded.Sequence);
+            return true;
+        }
+
+        Latest = Decoded;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+#include "TrackedVehicleClass.h"
+#include "TrackedVehicles.h"
+#include "TrackedMovementComponentStatics.h"
+#include "Curves/CurveFloat.h"
+
+UTrackedVehicleClass::UTrackedVehicleClass(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer) {
+}
+
+void UTrackedVehicleClass::PostLoad()
+{
+    Super::PostLoad();
+
+    // The curve may load after this asset, its keys must be in before the bake samples them
+    if(EngineTorqueCurve)
+    {
+        EngineTorqueCurve->ConditionalPostLoad();
+    }
+
+    // Cooked assets build once here, every vehicle of the model reads the result
+    this->BuildDerivedData();
+}
+
+#if WITH_EDITOR
+void UTrackedVehicleClass::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    this->BuildDerivedData();
+}
+#endif
+
+void UTrackedVehicleClass::BuildDerivedData()
+{
+    MomentInertia = TrackedCore::precalculateMomentOfInertia(SprocketMassKg, SprocketRadiusCm, TrackMassKg);
+
+    buildSurfaceTable(*this, SurfaceTable);
+    bakeEngineTorqueTable(*this, EngineTorqueTable);
+    buildGearbox(*this, EngineTorqueTable, Gearbox);
+
+    // Local axes of every unit are computed here, not per spawned vehicle
+    SuspensionTemplate.Reset();
+    SuspensionTemplate.Reserve(SuspesionSetupL.Num() + SuspesionSetupR.Num());
+    for(const FSuspensionSetup& setup : SuspesionSetupL)
+    {
+        SuspensionTemplate.Add(TrackedCore::ETrackSide::Left, toSuspensionUnitSetup(setup, setup.RootLoc, setup.RootRot.Quaternion()));
+    }
+    for(const FSuspensionSetup& setup : SuspesionSetupR)
+    {
+        SuspensionTemplate.Add(TrackedCore::ETrackSide::Right, toSuspensionUnitSetup(setup, setup.RootLoc, setup.RootRot.Quaternion()));
+    }
+
+    bDerivedDataBuilt = true;
+}
@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TrackedVehicleManager.h"
+#include "TrackedMovementComponent.h"
+#include "Async/ParallelFor.h"
+#include "Engine/World.h"
+
+namespace
+{
+	TMap<UWorld*, TUniquePtr<FTrackedVehicleManager>>& GetManagers()
+	{
+		static TMap<UWorld*, TUniquePtr<FTrackedVehicleManager>> Managers;
+		return Managers;
+	}
+}
+
+FTrackedVehicleManager::FTrackedVehicleManager(UWorld* InWorld)
+	: World(InWorld)
+{
+}
+
+FTrackedVehicleManager& FTrackedVehicleManager::Get(UWorld* World)
+{
+	check(IsInGameThread());
+
+	TUniquePtr<FTrackedVehicleManager>& Manager = GetManagers().FindOrAdd(World);
+	if (!Manager.IsValid())
+	{
+		Manager = TUniquePtr<FTrackedVehicleManager>(new FTrackedVehicleManager(World));
+	}
+	return *Manager;
+}
+
+void FTrackedVehicleManager::Unregister(UWorld* World, UTrackedMovementComponent* Vehicle)
+{
+	check(IsInGameThread());
+
+	TUniquePtr<FTrackedVehicleManager>* Manager = GetManagers().Find(World);
+	if (!Manager)
+	{
+		return;
+	}
+
+	if ((*Manager)->bTicking)
+	{
+		// Loops of the tick are walking Vehicles, leave a hole and compact after them.
+		// An emptied manager is no longer tickable, the world cleanup drops it
+		const int32 Index = (*Manager)->Vehicles.Find(Vehicle);
+		if (Index != INDEX_NONE)
+		{
+			(*Manager)->Vehicles[Index] = nullptr;
+		}
+		(*Manager)->PendingVehicles.RemoveSwap(Vehicle);
+		return;
+	}
+
+	(*Manager)->Vehicles.RemoveSwap(Vehicle);
+	if ((*Manager)->Vehicles.Num() == 0)
+	{
+		GetManagers().Remove(World);
+	}
+}
+
+void FTrackedVehicleManager::Remove(UWorld* World)
+{
+	check(IsInGameThread());
+
+	GetManagers().Remove(World);
+}
+
+void FTrackedVehicleManager::Register(UTrackedMovementComponent* Vehicle)
+{
+	if (bTicking)
+	{
+		// Joins from the next tick on
+		PendingVehicles.AddUnique(Vehicle);
+		return;
+	}
+
+	Vehicles.AddUnique(Vehicle);
+}
+
+bool FTrackedVehicleManager::IsTickable() const
+{
+	return Vehicles.Num() > 0 && !World->IsPaused();
+}
+
+TStatId FTrackedVehicleManager::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(FTrackedVehicleManager, STATGROUP_Tickables);
+}
+
+void FTrackedVehicleManager::Tick(float DeltaTime)
+{
+	// Vehicles unregistered by callbacks of the serial loops leave null slots until the end
+	bTicking = true;
+	const int32 Count = Vehicles.Num();
+
+	// Reads the physics bodies, picks LOD and sleep state
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		if (UTrackedMovementComponent* Vehicle = Vehicles[Index])
+		{
+			Vehicle->BeginSimulationTick(DeltaTime);
+		}
+	}
+
+	ParallelFor(Count, [this, DeltaTime](int32 Index)
+	{
+		if (UTrackedMovementComponent* Vehicle = Vehicles[Index])
+		{
+			Vehicle->SimulateDrivetrain(DeltaTime);
+			Vehicle->GatherSuspensionTraces();
+		}
+	});
+
+	// Scene queries (sync, async or custom backend)
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		if (UTrackedMovementComponent* Vehicle = Vehicles[Index])
+		{
+			Vehicle->ExecuteSuspensionTraces();
+		}
+	}
+
+	// Friction only fills the force accumulator of its vehicle, nothing reaches the engine before the apply loop
+	ParallelFor(Count, [this](int32 Index)
+	{
+		if (UTrackedMovementComponent* Vehicle = Vehicles[Index])
+		{
+			Vehicle->ConsumeSuspensionTraces();
+			Vehicle->EvaluateSuspensionForces();
+			Vehicle->ApplyDriveForcesAndGetFrictionForcesOnSides();
+		}
+	});
+
+	// Physics body writes, then the state replication sends and the replay log
+	for (int32 Index = 0; Index < Count; Index++)
+	{
+		if (UTrackedMovementComponent* Vehicle = Vehicles[Index])
+		{
+			Vehicle->ApplyAccumulatedForces();
+			Vehicle->FollowGroundKinematic();
+			Vehicle->CaptureNetState();
+			Vehicle->RecordReplayTick();
+		}
+	}
+
+	bTicking = false;
+	Vehicles.Remove(nullptr);
+	for (UTrackedMovementComponent* Vehicle : PendingVehicles)
+	{
+		Vehicles.AddUnique(Vehicle);
+	}
+	PendingVehicles.Reset();
+}
@@ -1,6 +1,10 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "TrackedVehiclePawn.h"
+#include "TrackedVehiclePool.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "GameFramework/Controller.h"
 
 FName ATrackedVehiclePawn::MeshComponentName(TEXT("TrackedVehicleMesh"));
 FName ATrackedVehiclePawn::MovementComponentName(TEXT("TrackedMovementComponent"));
@@ -10,4 +14,113 @@ ATrackedVehiclePawn::ATrackedVehiclePawn(const FObjectInitializer& ObjectInitial
     Mesh = CreateDefaultSubobject<USkeletalMeshComponent>(MeshComponentName);
     MovementComponent = CreateDefaultSubobject<UTrackedMovementComponent>(MovementComponentName);
     TracksBuilder = CreateDefaultSubobject<UTracksBuilderComponent>(TracksBuilderComponentName);
-}
\ No newline at end of file
+}
+
+ATrackedVehiclePawn* ATrackedVehiclePawn::SpawnPooled(UObject* WorldContextObject, TSubclassOf<ATrackedVehiclePawn> PawnClass, const FTransform& Transform)
+{
+    UWorld* world = GEngine->GetWorldFromContextObject(WorldContextObject);
+    if(!world)
+    {
+        return nullptr;
+    }
+
+    return FTrackedVehiclePool::Get(world).Acquire(PawnClass, Transform);
+}
+
+void ATrackedVehiclePawn::PrewarmPool(UObject* WorldContextObject, TSubclassOf<ATrackedVehiclePawn> PawnClass, int32 Count)
+{
+    UWorld* world = GEngine->GetWorldFromContextObject(WorldContextObject);
+    if(!world)
+    {
+        return;
+    }
+
+    FTrackedVehiclePool::Get(world).Prewarm(PawnClass, Count);
+}
+
+void ATrackedVehiclePawn::ReturnToPool()
+{
+    FTrackedVehiclePool::Get(GetWorld()).Release(this);
+}
+
+void ATrackedVehiclePawn::PossessedBy(AController* NewController)
+{
+    Super::PossessedBy(NewController);
+
+    // Inputs of the new owner start from its own sequence
+    if(MovementComponent)
+    {
+        MovementComponent->ResetNetState();
+    }
+}
+
+void ATrackedVehiclePawn::EnterPool()
+{
+    if(AController* controller = GetController())
+    {
+        controller->UnPossess();
+        // Players keep their controller, AI ones are spawned again with the vehicle
+        if(!controller->IsPlayerController())
+        {
+            controller->Destroy();
+        }
+    }
+
+    if(MovementComponent)
+    {
+        // Kinematic LOD has turned physics off, give the body back before its state is kept
+        MovementComponent->SetSimulationLod(TrackedCore::ESimulationLod::Full);
+        MovementComponent->Deactivate();
+    }
+    if(TracksBuilder)
+    {
+        TracksBuilder->Deactivate();
+    }
+
+    UPrimitiveComponent* body = Cast<UPrimitiveComponent>(GetRootComponent());
+    bPooledBodySimulated = body && body->IsSimulatingPhysics(NAME_None);
+    if(bPooledBodySimulated)
+    {
+        body->SetSimulatePhysics(false);
+    }
+
+    SetActorHiddenInGame(true);
+    SetActorEnableCollision(false);
+    SetActorTickEnabled(false);
+
+    bPooled = true;
+}
+
+void ATrackedVehiclePawn::LeavePool(const FTransform& Transform)
+{
+    SetActorTransform(Transform, false, nullptr, ETeleportType::TeleportPhysics);
+
+    UPrimitiveComponent* body = Cast<UPrimitiveComponent>(GetRootComponent());
+    if(body && bPooledBodySimulated)
+    {
+        body->SetSimulatePhysics(true);
+        body->SetPhysicsLinearVelocity(FVector::ZeroVector, false, NAME_None);
+        body->SetPhysicsAngularVelocity(FVector::ZeroVector, false, NAME_None);
+    }
+
+    SetActorHiddenInGame(false);
+    SetActorEnableCollision(true);
+    SetActorTickEnabled(true);
+
+    if(MovementComponent)
+    {
+        MovementComponent->ResetSimulationState();
+        MovementComponent->Activate(true);
+    }
+    if(TracksBuilder)
+    {
+        TracksBuilder->Activate(true);
+    }
+
+    if(!GetController() && (AutoPossessAI == EAutoPossessAI::Spawned || AutoPossessAI == EAutoPossessAI::PlacedInWorldOrSpawned))
+    {
+        SpawnDefaultController();
+    }
+
+    bPooled = false;
+}
@@ -0,0 +1,122 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TrackedVehiclePool.h"
+#include "TrackedVehiclePawn.h"
+#include "TrackedVehicles.h"
+#include "Engine/World.h"
+
+namespace
+{
+	TMap<UWorld*, TUniquePtr<FTrackedVehiclePool>>& GetPools()
+	{
+		static TMap<UWorld*, TUniquePtr<FTrackedVehiclePool>> Pools;
+		return Pools;
+	}
+}
+
+FTrackedVehiclePool::FTrackedVehiclePool(UWorld* InWorld)
+	: World(InWorld)
+{
+}
+
+FTrackedVehiclePool& FTrackedVehiclePool::Get(UWorld* World)
+{
+	check(IsInGameThread());
+
+	TUniquePtr<FTrackedVehiclePool>& Pool = GetPools().FindOrAdd(World);
+	if (!Pool.IsValid())
+	{
+		Pool = TUniquePtr<FTrackedVehiclePool>(new FTrackedVehiclePool(World));
+	}
+	return *Pool;
+}
+
+void FTrackedVehiclePool::Remove(UWorld* World)
+{
+	check(IsInGameThread());
+
+	GetPools().Remove(World);
+}
+
+ATrackedVehiclePawn* FTrackedVehiclePool::Acquire(TSubclassOf<ATrackedVehiclePawn> PawnClass, const FTransform& Transform)
+{
+	if (!PawnClass)
+	{
+		return nullptr;
+	}
+
+	if (TArray<TWeakObjectPtr<ATrackedVehiclePawn>>* Free = FreeVehicles.Find(*PawnClass))
+	{
+		while (Free->Num() > 0)
+		{
+			// Vehicles destroyed while parked leave stale entries behind
+			ATrackedVehiclePawn* Vehicle = Free->Pop(false).Get();
+			if (Vehicle && !Vehicle->IsPendingKill())
+			{
+				Vehicle->LeavePool(Transform);
+				return Vehicle;
+			}
+		}
+	}
+
+	return Spawn(PawnClass, Transform);
+}
+
+void FTrackedVehiclePool::Release(ATrackedVehiclePawn* Vehicle)
+{
+	if (!Vehicle || Vehicle->IsPooled() || Vehicle->IsPendingKill())
+	{
+		return;
+	}
+
+	check(Vehicle->GetWorld() == World);
+
+	Vehicle->EnterPool();
+	FreeVehicles.FindOrAdd(Vehicle->GetClass()).Add(Vehicle);
+}
+
+void FTrackedVehiclePool::Prewarm(TSubclassOf<ATrackedVehiclePawn> PawnClass, int32 Count)
+{
+	if (!PawnClass)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<ATrackedVehiclePawn>>& Free = FreeVehicles.FindOrAdd(*PawnClass);
+	Free.Reserve(Count);
+
+	for (int32 Index = NumFree(PawnClass); Index < Count; Index++)
+	{
+		// BeginPlay runs here, tables and suspension are ready before the vehicle is needed
+		if (ATrackedVehiclePawn* Vehicle = Spawn(PawnClass, FTransform::Identity))
+		{
+			Release(Vehicle);
+		}
+	}
+}
+
+int32 FTrackedVehiclePool::NumFree(TSubclassOf<ATrackedVehiclePawn> PawnClass) const
+{
+	int32 Count = 0;
+	if (const TArray<TWeakObjectPtr<ATrackedVehiclePawn>>* Free = FreeVehicles.Find(*PawnClass))
+	{
+		for (const TWeakObjectPtr<ATrackedVehiclePawn>& Vehicle : *Free)
+		{
+			Count += Vehicle.IsValid() ? 1 : 0;
+		}
+	}
+	return Count;
+}
+
+ATrackedVehiclePawn* FTrackedVehiclePool::Spawn(TSubclassOf<ATrackedVehiclePawn> PawnClass, const FTransform& Transform)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	ATrackedVehiclePawn* Vehicle = World->SpawnActor<ATrackedVehiclePawn>(PawnClass, Transform, SpawnParams);
+	if (!Vehicle)
+	{
+		UE_LOG(LogTrackedVehicles, Warning, TEXT("Vehicle pool could not spawn %s"), *PawnClass->GetName());
+	}
+	return Vehicle;
+}
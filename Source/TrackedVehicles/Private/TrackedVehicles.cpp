@@ -1,18 +1,46 @@
 // Copyright 1998-2017 Epic Games, Inc. All Rights Reserved.
 
 #include "TrackedVehicles.h"
+#include "TrackedVehicleManager.h"
+#include "TrackedVehiclePool.h"
+#include "Engine/World.h"
 
 #define LOCTEXT_NAMESPACE "FTrackedVehiclesModule"
 
+DEFINE_LOG_CATEGORY(LogTrackedVehicles);
+
+DEFINE_STAT(STAT_TrackedBeginTick);
+DEFINE_STAT(STAT_TrackedDrivetrain);
+DEFINE_STAT(STAT_TrackedGatherTraces);
+DEFINE_STAT(STAT_TrackedExecuteTraces);
+DEFINE_STAT(STAT_TrackedConsumeTraces);
+DEFINE_STAT(STAT_TrackedSuspensionForces);
+DEFINE_STAT(STAT_TrackedFriction);
+DEFINE_STAT(STAT_TrackedApplyForces);
+DEFINE_STAT(STAT_TrackedGroundFollow);
+
+DEFINE_STAT(STAT_TrackedTraces);
+DEFINE_STAT(STAT_TrackedEngagedContacts);
+DEFINE_STAT(STAT_TrackedForcesApplied);
+DEFINE_STAT(STAT_TrackedSleepingVehicles);
+
 void FTrackedVehiclesModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
+
+	// Parked vehicles go away with their world, so do its pool and an emptied manager
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda([](UWorld* World, bool /*bSessionEnded*/, bool /*bCleanupResources*/)
+	{
+		FTrackedVehiclePool::Remove(World);
+		FTrackedVehicleManager::Remove(World);
+	});
 }
 
 void FTrackedVehiclesModule::ShutdownModule()
 {
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
 }
 
 #undef LOCTEXT_NAMESPACE
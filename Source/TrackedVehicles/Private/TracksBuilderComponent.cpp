@@ -1,3 +1,284 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "TracksBuilderComponent.h"
+#include "TrackedMovementComponent.h"
+#include "TrackedVehicles.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "Materials/MaterialParameterCollection.h"
+#include "Materials/MaterialParameterCollectionInstance.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+// Per primitive material data, pushed without dynamic material instances
+#define TRACKS_CUSTOM_PRIMITIVE_DATA (ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION >= 25)
+
+namespace
+{
+    TrackedCore::FVec3 toTrackPoint(const FVector& v)
+    {
+        return TrackedCore::FVec3(v.X, v.Y, v.Z);
+    }
+
+    FTransform toLinkTransform(const TrackedCore::FTrackLinkTransform& link, const FVector& scale)
+    {
+        return FTransform(
+            FQuat(link.Rotation.X, link.Rotation.Y, link.Rotation.Z, link.Rotation.W),
+            FVector(link.Location.X, link.Location.Y, link.Location.Z),
+            scale);
+    }
+}
+
+UTracksBuilderComponent::UTracksBuilderComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer) {
+
+	// Links follow the tread offsets the movement component interpolates during its tick
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
+
+	LinkComponentClass = UInstancedStaticMeshComponent::StaticClass();
+}
+
+void UTracksBuilderComponent::BeginPlay()
+{
+    Super::BeginPlay();
+
+    Movement = GetOwner()->FindComponentByClass<UTrackedMovementComponent>();
+    if(Movement)
+    {
+        AddTickPrerequisiteComponent(Movement);
+
+        // A vehicle class brings its splines and suspension units in the movement BeginPlay, which may run after this one
+        Movement->OnVehicleClassApplied.AddUObject(this, &UTracksBuilderComponent::BuildTracks);
+    }
+
+    this->BuildTracks();
+}
+
+void UTracksBuilderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if(Movement)
+    {
+        Movement->OnVehicleClassApplied.RemoveAll(this);
+    }
+    this->DestroyLinks();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void UTracksBuilderComponent::BuildTracks()
+{
+    this->DestroyLinks();
+
+    NumLinksOnSide = 0;
+    PathLeft = TrackedCore::FTrackPath();
+    PathRight = TrackedCore::FTrackPath();
+
+    if(Movement && RenderMode == ETrackRenderMode::ScrollingMaterial)
+    {
+        this->BuildTreadMaterial();
+        return;
+    }
+
+    if(!Movement || !LinkMesh || !LinkComponentClass)
+    {
+        return;
+    }
+
+    this->BuildPath(Movement->SplineCoordinatesL, PathLeft);
+    this->BuildPath(Movement->SplineCoordinatesR, PathRight);
+    if(!PathLeft.IsValid() || !PathRight.IsValid())
+    {
+        UE_LOG(LogTrackedVehicles, Warning, TEXT("%s: track splines need at least two points per side"), *GetName());
+        return;
+    }
+
+    BindingLeft = TrackedCore::FTrackPathBinding();
+    BindingRight = TrackedCore::FTrackPathBinding();
+    if(FollowSuspension)
+    {
+        const TrackedCore::FSuspensionStore& suspensions = Movement->GetSuspensionStore();
+        TrackedCore::bindTrackPath(PathLeft, suspensions, TrackedCore::ETrackSide::Left, SplineSuspensionRatio, BindingLeft);
+        TrackedCore::bindTrackPath(PathRight, suspensions, TrackedCore::ETrackSide::Right, SplineSuspensionRatio, BindingRight);
+    }
+
+    NumLinksOnSide = FMath::Max(1, FMath::RoundToInt(Movement->TreadsOnSide));
+    LinkTransforms.resize(NumLinksOnSide);
+
+    LinksLeft = this->CreateLinks(TEXT("TrackLinksLeft"));
+    LinksRight = this->CreateLinks(TEXT("TrackLinksRight"));
+
+    // Fill the instances once, ticks only move them
+    UInstancedStaticMeshComponent* sideLinks[] = { LinksLeft, LinksRight };
+    const TrackedCore::FTrackPath* sidePaths[] = { &PathLeft, &PathRight };
+
+    for(int side = 0; side < 2; side++)
+    {
+        TrackedCore::placeTrackLinks(*sidePaths[side], 0.0f, NumLinksOnSide, Movement->TreadHalfThickness, TrackedCore::FTrackLoopRange(0, NumLinksOnSide), LinkTransforms.data());
+        for(const TrackedCore::FTrackLinkTransform& link : LinkTransforms)
+        {
+            sideLinks[side]->AddInstance(toLinkTransform(link, LinkScale));
+        }
+    }
+
+    LinkPhaseLeft = 0.0f;
+    LinkPhaseRight = 0.0f;
+}
+
+void UTracksBuilderComponent::BuildTreadMaterial()
+{
+    TreadComponent = Cast<UPrimitiveComponent>(Movement->UpdatedComponent);
+    if(!TreadComponentName.IsNone())
+    {
+        TInlineComponentArray<UPrimitiveComponent*> components(GetOwner());
+        for(UPrimitiveComponent* component : components)
+        {
+            if(component->GetFName() == TreadComponentName)
+            {
+                TreadComponent = component;
+                break;
+            }
+        }
+    }
+
+    TreadParameters = TreadParameterCollection ? GetWorld()->GetParameterCollectionInstance(TreadParameterCollection) : nullptr;
+
+    // Force the first push
+    TreadUVOffsetLeft = -1.0f;
+    TreadUVOffsetRight = -1.0f;
+}
+
+void UTracksBuilderComponent::BuildPath(const TArray<FVector>& coordinates, TrackedCore::FTrackPath& outPath) const
+{
+    // One set of tangents serves both sides, they only differ in Y
+    const TArray<FVector>& tangents = Movement->SplineTangents;
+    const bool hasTangents = tangents.Num() == coordinates.Num();
+
+    std::vector<TrackedCore::FVec3> points(coordinates.Num());
+    std::vector<TrackedCore::FVec3> pointTangents(hasTangents ? tangents.Num() : 0);
+    for(int index = 0; index < coordinates.Num(); index++)
+    {
+        points[index] = toTrackPoint(coordinates[index]);
+        if(hasTangents)
+        {
+            pointTangents[index] = toTrackPoint(tangents[index]);
+        }
+    }
+
+    outPath.Build(points.data(), hasTangents ? pointTangents.data() : nullptr, (int)points.size(), PathSamplesPerSegment);
+}
+
+UInstancedStaticMeshComponent* UTracksBuilderComponent::CreateLinks(FName name)
+{
+    AActor* owner = GetOwner();
+    USceneComponent* hull = Movement->UpdatedComponent ? Movement->UpdatedComponent : owner->GetRootComponent();
+
+    UInstancedStaticMeshComponent* links = NewObject<UInstancedStaticMeshComponent>(owner, LinkComponentClass, name);
+    links->SetStaticMesh(LinkMesh);
+    links->SetMobility(EComponentMobility::Movable);
+    // Links are visual only, per instance bodies would be moved on every update
+    links->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    links->SetupAttachment(hull);
+    links->RegisterComponent();
+
+    return links;
+}
+
+void UTracksBuilderComponent::DestroyLinks()
+{
+    UInstancedStaticMeshComponent* sideLinks[] = { LinksLeft, LinksRight };
+    for(UInstancedStaticMeshComponent* links : sideLinks)
+    {
+        if(links)
+        {
+            links->DestroyComponent();
+        }
+    }
+
+    LinksLeft = nullptr;
+    LinksRight = nullptr;
+}
+
+void UTracksBuilderComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+    Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+    if(!Movement)
+    {
+        return;
+    }
+
+    if(RenderMode == ETrackRenderMode::ScrollingMaterial)
+    {
+        this->UpdateTreadMaterial();
+        return;
+    }
+
+    if(NumLinksOnSide == 0)
+    {
+        return;
+    }
+
+    this->UpdateLinks(LinksLeft, PathLeft, BindingLeft, Movement->GetVisualTreadOffsetLeft(), LinkPhaseLeft);
+    this->UpdateLinks(LinksRight, PathRight, BindingRight, Movement->GetVisualTreadOffsetRight(), LinkPhaseRight);
+}
+
+void UTracksBuilderComponent::UpdateTreadMaterial()
+{
+    const float left = Movement->GetTreadUVOffsetLeft();
+    const float right = Movement->GetTreadUVOffsetRight();
+    if(left == TreadUVOffsetLeft && right == TreadUVOffsetRight)
+    {
+        return;
+    }
+    TreadUVOffsetLeft = left;
+    TreadUVOffsetRight = right;
+
+#if TRACKS_CUSTOM_PRIMITIVE_DATA
+    if(TreadComponent)
+    {
+        TreadComponent->SetCustomPrimitiveDataVector2(TreadUVDataIndex, FVector2D(left, right));
+        return;
+    }
+#endif
+
+    // Collection values are global: give each vehicle its own parameter, or scroll only the vehicle of interest
+    if(TreadParameters)
+    {
+        TreadParameters->SetVectorParameterValue(TreadUVOffsetParameter, FLinearColor(left, right, 0.0f, 0.0f));
+    }
+}
+
+void UTracksBuilderComponent::UpdateLinks(UInstancedStaticMeshComponent* links, TrackedCore::FTrackPath& path, TrackedCore::FTrackPathBinding& binding, float treadOffset, float& inOutPhase)
+{
+    // Resample only the segments next to wheels that moved
+    TrackedCore::FTrackLoopRange dirtySegments;
+    if(FollowSuspension && binding.IsBound())
+    {
+        dirtySegments = TrackedCore::updateTrackPath(path, binding, Movement->GetSuspensionStore(), FollowSuspensionEpsilon);
+    }
+
+    // Tread offset wraps at TreadLenght, scale it onto the spline so the wrap lands on the same link position
+    const float phase = Movement->TreadLenght > 0.0f ? treadOffset / Movement->TreadLenght * path.GetLength() : treadOffset;
+
+    // Moving treads move every link, otherwise only the links on resampled segments
+    TrackedCore::FTrackLoopRange dirtyLinks = phase != inOutPhase
+        ? TrackedCore::FTrackLoopRange(0, NumLinksOnSide)
+        : TrackedCore::linksOnSegments(path, phase, NumLinksOnSide, dirtySegments);
+    if(dirtyLinks.IsEmpty())
+    {
+        return;
+    }
+    inOutPhase = phase;
+
+    TrackedCore::placeTrackLinks(path, phase, NumLinksOnSide, Movement->TreadHalfThickness, dirtyLinks, LinkTransforms.data());
+
+    // Move the instances without touching the render state, then send the side to the renderer once
+    for(int link = 0; link < dirtyLinks.Count; link++)
+    {
+        const int instance = (dirtyLinks.First + link) % NumLinksOnSide;
+        links->UpdateInstanceTransform(instance, toLinkTransform(LinkTransforms[link], LinkScale), false, false, true);
+    }
+    links->MarkRenderStateDirty();
+}
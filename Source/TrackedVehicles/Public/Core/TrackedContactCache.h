@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Core/TrackedGroundQuery.h"
+#include <cstdint>
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief When a cached suspension contact may stand in for a new sweep
+    struct FContactCacheSettings
+    {
+        // Both ends of the sweep segment must stay this close to the traced one (cm)
+        float MaxSegmentMove = 2.0f;
+        // Contact is traced again after this many reused ticks
+        int MaxReuseTicks = 8;
+    };
+
+    /// @brief Last traced contact of every suspension unit (structure of arrays)
+    /// @details A unit whose sweep barely moved is answered by sweeping its sphere
+    /// against the cached contact plane, only the remaining units are swept for real.
+    /// Only hits on static geometry may be cached, the caller decides which are.
+    struct FContactCache
+    {
+        // Per suspension unit
+        std::vector<FSweepRequest> TracedRequest;
+        std::vector<FVec3> PlanePoint;
+        std::vector<FVec3> PlaneNormal;
+        std::vector<uint8_t> SurfaceType;
+        std::vector<uint8_t> Valid;
+        std::vector<int> Age;
+        // Contact of this tick came from the cache
+        std::vector<uint8_t> Reused;
+
+        // Sweeps still to run this tick, PendingTraces maps them back to the traced batch
+        FSweepBatch PendingSweeps;
+        std::vector<int> PendingTraces;
+        // Set to 0 by the caller for hits on geometry that may move
+        std::vector<uint8_t> PendingCacheable;
+
+        int Num() const { return (int)Valid.size(); }
+
+        /// @brief Size for the suspension store, drops every cached contact
+        void Resize(int numUnits);
+        void InvalidateAll();
+
+        /// @brief Answer traced units from the cache and queue the others in PendingSweeps
+        void Prepare(FSweepBatch& traces, const std::vector<int>& tracedUnits, const FContactCacheSettings& settings);
+
+        /// @brief Copy PendingSweeps results into traces and cache them
+        void Resolve(FSweepBatch& traces, const std::vector<int>& tracedUnits);
+    };
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+// Engine independent math used by the tracked vehicle simulation core.
+// Nothing in Core/ may include engine headers: the same sources are compiled
+// into the TrackedVehicles module and into the headless CMake build.
+
+#include <cmath>
+
+namespace TrackedCore
+{
+    const float M2CM = 100.0f;
+    const float Epsilon = 0.000001f;
+    const float Pi = 3.1415926535897932f;
+    const float DegToRad = Pi / 180.0f;
+    // cm/s^2, same as the default world gravity
+    const float StandardGravityCm = 980.0f;
+
+    // fsign function to get sign part of numeric types
+    template <typename T> int fsign(T val)
+    {
+        return (T(0) < val) - (val < T(0));
+    }
+
+    template <typename T> T fclamp(T val, T minVal, T maxVal)
+    {
+        return val < minVal ? minVal : (val > maxVal ? maxVal : val);
+    }
+
+    /// @brief Plain 3d vector (centimeters, same axes as FVector)
+    struct FVec3
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+
+        FVec3() {}
+        FVec3(float x, float y, float z) : X(x), Y(y), Z(z) {}
+
+        FVec3 operator+(const FVec3& v) const { return FVec3(X + v.X, Y + v.Y, Z + v.Z); }
+        FVec3 operator-(const FVec3& v) const { return FVec3(X - v.X, Y - v.Y, Z - v.Z); }
+        FVec3 operator*(float s) const { return FVec3(X * s, Y * s, Z * s); }
+        FVec3 operator/(float s) const { return FVec3(X / s, Y / s, Z / s); }
+        FVec3 operator-() const { return FVec3(-X, -Y, -Z); }
+        FVec3& operator+=(const FVec3& v) { X += v.X; Y += v.Y; Z += v.Z; return *this; }
+        FVec3& operator-=(const FVec3& v) { X -= v.X; Y -= v.Y; Z -= v.Z; return *this; }
+
+        float SizeSquared() const { return X * X + Y * Y + Z * Z; }
+        float Size() const { return std::sqrt(SizeSquared()); }
+    };
+
+    /// @brief Plain rotation quaternion (same convention as FQuat)
+    struct FQuat4
+    {
+        float X = 0.0f;
+        float Y = 0.0f;
+        float Z = 0.0f;
+        float W = 1.0f;
+
+        FQuat4() {}
+        FQuat4(float x, float y, float z, float w) : X(x), Y(y), Z(z), W(w) {}
+    };
+
+    inline float dot(const FVec3& a, const FVec3& b)
+    {
+        return a.X * b.X + a.Y * b.Y + a.Z * b.Z;
+    }
+
+    inline FVec3 cross(const FVec3& a, const FVec3& b)
+    {
+        return FVec3(a.Y * b.Z - a.Z * b.Y, a.Z * b.X - a.X * b.Z, a.X * b.Y - a.Y * b.X);
+    }
+
+    inline float distance(const FVec3& a, const FVec3& b)
+    {
+        return (a - b).Size();
+    }
+
+    // Zero vector for degenerated input, same as FVector::GetSafeNormal
+    inline FVec3 safeNormal(const FVec3& v)
+    {
+        float squareSum = v.SizeSquared();
+        if(squareSum < 1.e-8f)
+        {
+            return FVec3();
+        }
+        return v * (1.0f / std::sqrt(squareSum));
+    }
+
+    inline FVec3 projectVectorOnToVector(const FVec3& v, const FVec3& target)
+    {
+        float targetSquare = target.SizeSquared();
+        if(targetSquare < 1.e-8f)
+        {
+            return FVec3();
+        }
+        return target * (dot(v, target) / targetSquare);
+    }
+
+    inline FVec3 projectVectorToPlane(const FVec3& v, const FVec3& planeNormal)
+    {
+        return v - planeNormal * dot(v, planeNormal);
+    }
+
+    inline FVec3 rotateVector(const FQuat4& q, const FVec3& v)
+    {
+        FVec3 axis(q.X, q.Y, q.Z);
+        FVec3 t = cross(axis, v) * 2.0f;
+        return v + t * q.W + cross(axis, t);
+    }
+
+    /// @brief Rotation that takes the unit axes onto the orthonormal basis x, y, z
+    inline FQuat4 quatFromAxes(const FVec3& x, const FVec3& y, const FVec3& z)
+    {
+        const float trace = x.X + y.Y + z.Z;
+        if(trace > 0.0f)
+        {
+            const float s = 0.5f / std::sqrt(trace + 1.0f);
+            return FQuat4((y.Z - z.Y) * s, (z.X - x.Z) * s, (x.Y - y.X) * s, 0.25f / s);
+        }
+        if(x.X > y.Y && x.X > z.Z)
+        {
+            const float s = 2.0f * std::sqrt(1.0f + x.X - y.Y - z.Z);
+            return FQuat4(0.25f * s, (y.X + x.Y) / s, (z.X + x.Z) / s, (y.Z - z.Y) / s);
+        }
+        if(y.Y > z.Z)
+        {
+            const float s = 2.0f * std::sqrt(1.0f + y.Y - x.X - z.Z);
+            return FQuat4((y.X + x.Y) / s, 0.25f * s, (z.Y + y.Z) / s, (z.X - x.Z) / s);
+        }
+        const float s = 2.0f * std::sqrt(1.0f + z.Z - x.X - y.Y);
+        return FQuat4((z.X + x.Z) / s, (z.Y + y.Z) / s, 0.25f * s, (x.Y - y.X) / s);
+    }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief Difference between a baked table and its source curve
+    struct FCurveTableAccuracy
+    {
+        float MaxAbsError = 0.0f;
+        float MaxErrorTime = 0.0f;
+        float RmsError = 0.0f;
+        int NumSamples = 0;
+    };
+
+    /// @brief Uniformly sampled curve with linear interpolation and cached time range
+    /// @details Plain data, safe to evaluate from any thread.
+    struct FCurveTable
+    {
+        float MinTime = 0.0f;
+        float MaxTime = 0.0f;
+        float InvStep = 0.0f;
+        std::vector<float> Values;
+
+        bool IsValid() const { return Values.size() >= 2; }
+
+        float Clamp(float time) const
+        {
+            return fclamp(time, MinTime, MaxTime);
+        }
+
+        float Evaluate(float time) const
+        {
+            float position = (Clamp(time) - MinTime) * InvStep;
+            // NaN passes the clamp, the cast below must only see positions inside the table
+            if(!(position > 0.0f))
+            {
+                return Values[0];
+            }
+
+            int lastIndex = (int)Values.size() - 1;
+            int index = (int)position;
+            if(index >= lastIndex)
+            {
+                return Values[lastIndex];
+            }
+
+            float alpha = position - (float)index;
+            return Values[index] + (Values[index + 1] - Values[index]) * alpha;
+        }
+
+        /// @brief Sample curve(time) at numSamples uniform points of [minTime, maxTime]
+        template <typename CurveType>
+        void Build(float minTime, float maxTime, int numSamples, const CurveType& curve)
+        {
+            if(numSamples < 2)
+            {
+                numSamples = 2;
+            }
+
+            MinTime = minTime;
+            MaxTime = maxTime;
+            InvStep = maxTime > minTime ? (float)(numSamples - 1) / (maxTime - minTime) : 0.0f;
+
+            Values.resize(numSamples);
+            for(int index = 0; index < numSamples; index++)
+            {
+                Values[index] = curve(minTime + (maxTime - minTime) * (float)index / (float)(numSamples - 1));
+            }
+        }
+
+        void Reset()
+        {
+            MinTime = 0.0f;
+            MaxTime = 0.0f;
+            InvStep = 0.0f;
+            Values.clear();
+        }
+    };
+
+    /// @brief Compare the table against curve(time) at numSamples uniform points
+    template <typename CurveType>
+    FCurveTableAccuracy measureCurveTableAccuracy(const FCurveTable& table, const CurveType& curve, int numSamples)
+    {
+        FCurveTableAccuracy accuracy;
+        if(!table.IsValid() || numSamples < 2)
+        {
+            return accuracy;
+        }
+
+        double squareSum = 0.0;
+        for(int index = 0; index < numSamples; index++)
+        {
+            float time = table.MinTime + (table.MaxTime - table.MinTime) * (float)index / (float)(numSamples - 1);
+            float error = std::fabs(table.Evaluate(time) - curve(time));
+
+            squareSum += (double)error * (double)error;
+            if(error > accuracy.MaxAbsError)
+            {
+                accuracy.MaxAbsError = error;
+                accuracy.MaxErrorTime = time;
+            }
+        }
+
+        accuracy.NumSamples = numSamples;
+        accuracy.RmsError = (float)std::sqrt(squareSum / numSamples);
+        return accuracy;
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+
+namespace TrackedCore
+{
+    /// @brief Static and kinetic friction coefficients resolved for a contact
+    struct FFrictionMu
+    {
+        float Static = 0.0f;
+        float Kinetic = 0.0f;
+    };
+
+    inline float precalculateMomentOfInertia(float sprocketMassKg, float sprocketRadiusCm, float trackMassKg)
+    {
+        float squareRadius = sprocketRadiusCm * sprocketRadiusCm;
+        float trackMassOnSquareRadius = trackMassKg * squareRadius;
+
+        return ((sprocketMassKg * 0.5f) * squareRadius) + trackMassOnSquareRadius;
+    }
+
+    // TODO: Move magic numbers to constants
+    inline float calculateTorqueTransfer(float wheelCoefficient, float forwardCoefficient)
+    {
+        return fclamp(wheelCoefficient + forwardCoefficient, -1.0f, 2.0f);
+    }
+
+    inline float calculateThrottleIncrement(float torqueTransferRight, float torqueTransferLeft)
+    {
+        // TODO: Epsilon compare
+        return std::fmax(std::fabs(torqueTransferRight), std::fabs(torqueTransferLeft)) != 0.0f ? 0.5f : -1.0f;
+    }
+
+    inline float calculateThrottle(float throttle, float throttleIncrement, float dt)
+    {
+        return fclamp(throttle + throttleIncrement * dt, 0.0f, 1.0f);
+    }
+
+    inline float calculateInertia(float angVel, float torque, float inertia, float dt)
+    {
+        return angVel + (torque / inertia) * dt;
+    }
+
+    inline float calculateBrake(float angVelIn, float brakeRatio, float brakeForce, float dt)
+    {
+        float brakeCoef = brakeRatio * brakeForce * dt;
+        if(std::fabs(angVelIn) > std::fabs(brakeCoef))
+        {
+            return angVelIn - (brakeCoef * fsign(angVelIn));
+        }
+        else
+        {
+            return angVelIn;
+        }
+    }
+
+    inline float calculateAxleAngularVelocity(float trackRightAngVel, float trackLeftAngVel)
+    {
+        return (std::fabs(trackRightAngVel) + std::fabs(trackLeftAngVel)) / 2.0f;
+    }
+
+    /// @brief Rolling resistance of a track, always against its spin
+    inline float calculateRollingFrictionTorque(float trackAngVel, float wheelLoad, float rollingFrictionCoef, float sprocketRadiusCm)
+    {
+        if(std::fabs(trackAngVel) <= Epsilon)
+        {
+            return 0.0f;
+        }
+        return -fsign(trackAngVel) * wheelLoad * rollingFrictionCoef * sprocketRadiusCm;
+    }
+
+    /// @brief Ground reaction of a track that does not slip (kinematic LOD)
+    /// @details The hull share of the mass is reflected through the sprocket, so the
+    /// drive accelerates track and hull together instead of a free spinning track.
+    inline float calculateNoSlipFrictionTorque(float driveTorque, float momentInertia, float hullMassKg, float sprocketRadiusCm)
+    {
+        float hullInertia = hullMassKg * sprocketRadiusCm * sprocketRadiusCm;
+        if(hullInertia <= 0.0f)
+        {
+            return 0.0f;
+        }
+        return -driveTorque * hullInertia / (momentInertia + hullInertia);
+    }
+
+    inline float calculateEngineRPM(float angVel, float gearRatio, float diferentialRatio)
+    {
+        return (angVel * gearRatio * diferentialRatio * 60.0f) / (Pi * 2.0f);
+    }
+
+    /// @brief Torque on the axle for the engine torque through gear and differential
+    inline float calculateDriveAxleTorque(float engineTorque, float gearRatio, float diferentialRatio, float transmissionEfficiency)
+    {
+        return engineTorque * gearRatio * diferentialRatio * transmissionEfficiency;
+    }
+
+    /// @brief Friction coefficients of the track at given slide direction
+    /// @param velocityDirection normalized slide velocity
+    /// @param forwardVector track forward axis
+    FFrictionMu getMuFromFrictionEllipse(
+        const FVec3& velocityDirection,
+        const FVec3& forwardVector,
+        float muXStatic,
+        float muYStatic,
+        float muXKinetic,
+        float muYKinetic);
+}
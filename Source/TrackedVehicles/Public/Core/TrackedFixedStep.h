@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+
+namespace TrackedCore
+{
+    /// @brief Accumulator splitting variable frame time into fixed simulation steps
+    struct FFixedStepAccumulator
+    {
+        float StepSeconds = 1.0f / 120.0f;
+        int MaxSubsteps = 8;
+        float Accumulator = 0.0f;
+
+        /// @return number of fixed steps to simulate for this frame
+        /// @details Time above MaxSubsteps steps is dropped, a hitch slows the
+        /// simulation down instead of feeding it a huge step.
+        int Advance(float deltaTime)
+        {
+            Accumulator += deltaTime;
+
+            int steps = (int)(Accumulator / StepSeconds);
+            if(steps > MaxSubsteps)
+            {
+                steps = MaxSubsteps;
+                Accumulator = 0.0f;
+                return steps;
+            }
+
+            Accumulator -= steps * StepSeconds;
+            return steps;
+        }
+
+        /// @brief Fraction of the next step already elapsed, for visual interpolation
+        float Alpha() const
+        {
+            return fclamp(Accumulator / StepSeconds, 0.0f, 1.0f);
+        }
+
+        void Reset()
+        {
+            Accumulator = 0.0f;
+        }
+    };
+
+    /// @brief Keep a tread travel distance inside [0, treadLength)
+    inline float wrapTreadOffset(float offset, float treadLength)
+    {
+        if(treadLength <= 0.0f)
+        {
+            return offset;
+        }
+
+        float wrapped = std::fmod(offset, treadLength);
+        return wrapped < 0.0f ? wrapped + treadLength : wrapped;
+    }
+
+    /// @brief Texture scroll in [0, 1) of a tread with uvTiles texture repeats along treadLength
+    inline float treadUVOffset(float offset, float treadLength, float uvTiles)
+    {
+        if(treadLength <= 0.0f)
+        {
+            return 0.0f;
+        }
+
+        float scroll = std::fmod(offset / treadLength * uvTiles, 1.0f);
+        return scroll < 0.0f ? scroll + 1.0f : scroll;
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+
+namespace TrackedCore
+{
+    /// @brief Net force and torque about the center of mass of one body
+    /// @details Forces at locations are summed during the tick and handed to the
+    /// physics engine as one force and one torque.
+    struct FForceAccumulator
+    {
+        FVec3 CenterOfMass;
+        FVec3 Force;
+        FVec3 Torque;
+        int NumForces = 0;
+
+        void Reset(const FVec3& centerOfMass)
+        {
+            CenterOfMass = centerOfMass;
+            Force = FVec3();
+            Torque = FVec3();
+            NumForces = 0;
+        }
+
+        void AddForce(const FVec3& force)
+        {
+            Force += force;
+            NumForces++;
+        }
+
+        void AddForceAtLocation(const FVec3& force, const FVec3& location)
+        {
+            Force += force;
+            Torque += cross(location - CenterOfMass, force);
+            NumForces++;
+        }
+
+        bool IsEmpty() const
+        {
+            return NumForces == 0;
+        }
+    };
+}
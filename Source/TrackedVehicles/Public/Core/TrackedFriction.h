@@ -0,0 +1,101 @@
+#pragma once
+
+#include "Core/TrackedForceAccumulator.h"
+#include "Core/TrackedSurfaceTable.h"
+#include "Core/TrackedSuspensionStore.h"
+#include "Core/TrackedVehicleFrame.h"
+#include <cstdint>
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief Engaged contacts of both tracks gathered for the batched friction solve
+    /// @details Structure of arrays, one lane per contact. Inputs are filled by
+    /// Set after a Resize to the contact count, outputs by solveContactFriction.
+    struct FFrictionContactBatch
+    {
+        // Inputs (world space, normals unit length)
+        std::vector<float> NormalX, NormalY, NormalZ;
+        // Contact point velocity minus track surface velocity
+        std::vector<float> SlipX, SlipY, SlipZ;
+        std::vector<float> SuspensionForceX, SuspensionForceY, SuspensionForceZ;
+        std::vector<float> DriveX, DriveY, DriveZ;
+        // Friction ellipse of the contact surface
+        std::vector<float> MuXStatic, MuYStatic, MuXKinetic, MuYKinetic;
+        std::vector<float> RollingFrictionCoef;
+        std::vector<int> Unit;
+
+        // Outputs
+        std::vector<float> ForceX, ForceY, ForceZ;
+        // Friction part of the force along the hull forward axis (reaction drags the track)
+        std::vector<float> FrictionAlongForward;
+        std::vector<float> WheelLoad;
+
+        int Num() const { return (int)Unit.size(); }
+
+        void Reserve(int count);
+        void Resize(int count);
+        void Set(int contact, int unit, const FVec3& normal, const FVec3& slip, const FVec3& suspensionForce, const FVec3& drive, const FSurfaceParams& surface);
+    };
+
+    /// @brief Hull axes and the velocity-to-force scale shared by all contacts
+    struct FFrictionSolveParams
+    {
+        FVec3 Forward;
+        FVec3 Right;
+        // Body mass / dt / number of contacts: force cancelling the slip in one step
+        float SlipToForce = 0.0f;
+    };
+
+    /// @brief Static/kinetic friction and drive force of every gathered contact
+    /// @details Per contact: wheel load from the suspension force along the normal,
+    /// mu from the friction ellipse of the slip direction, full static friction and
+    /// drive force in the contact plane. Below the static limit (load * muStatic) the
+    /// full static force is applied, above it the kinetic force clamped to
+    /// load * muKinetic. Runs in SSE2/AVX2 lanes with a scalar remainder.
+    void solveContactFriction(FFrictionContactBatch& batch, const FFrictionSolveParams& params);
+
+    /// @brief Scalar reference of solveContactFriction
+    void solveContactFrictionScalar(FFrictionContactBatch& batch, const FFrictionSolveParams& params);
+
+    struct FTrackFrictionParams
+    {
+        // Friction of each contact comes from the surface it hit, must be set
+        const FSurfaceTable* Surfaces = nullptr;
+        float SprocketRadiusCm = 24.05f;
+    };
+
+    struct FTrackFrictionInputs
+    {
+        float DriveTorqueLeft = 0.0f;
+        float DriveTorqueRight = 0.0f;
+        float TrackLinVelLeft = 0.0f;
+        float TrackLinVelRight = 0.0f;
+        float TrackAngVelLeft = 0.0f;
+        float TrackAngVelRight = 0.0f;
+        float DT = 0.0f;
+    };
+
+    struct FTrackFrictionResult
+    {
+        float FrictionTorqueLeft = 0.0f;
+        float FrictionTorqueRight = 0.0f;
+        float RollingFrictionTorqueLeft = 0.0f;
+        float RollingFrictionTorqueRight = 0.0f;
+        int NumContacts = 0;
+    };
+
+    /// @brief Rolling resistance averaged over the engaged units, for LODs without contacts
+    float averageRollingFrictionCoef(const FSuspensionStore& suspensions, const FSurfaceTable& surfaces);
+
+    /// @brief Gather engaged contacts of both tracks, solve friction in one batch,
+    /// add the contact forces to the body and return per track torques
+    void solveTrackFriction(
+        const FSuspensionStore& suspensions,
+        const FVehicleFrame& frame,
+        const FTrackFrictionParams& params,
+        const FTrackFrictionInputs& inputs,
+        FFrictionContactBatch& batch,
+        FForceAccumulator& bodyForces,
+        FTrackFrictionResult& outResult);
+}
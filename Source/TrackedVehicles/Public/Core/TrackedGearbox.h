@@ -0,0 +1,123 @@
+#pragma once
+
+#include "Core/TrackedDrivetrain.h"
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief Shift points of the automatic gearbox
+    struct FGearboxSettings
+    {
+        // Fractions of the engine RPM range, used when the torque curve gives no better point
+        float UpShiftPrc = 0.9f;
+        float DownShiftPrc = 0.05f;
+        // Down shift happens at least this fraction of axle speed under the up shift into the gear
+        float Hysteresis = 0.1f;
+        // Seconds between two automatic shifts
+        float ShiftDelay = 0.5f;
+        // Axle speed (rad/s) under which the direction of travel may change
+        float StopAngVel = 0.5f;
+    };
+
+    /// @brief Gear ratios with axle speed shift thresholds precomputed per gear
+    /// @details Ratios are ordered like GearRatios: reverse gears (negative) first, then
+    /// neutral (zero, optional), then forward gears. Thresholds are axle angular velocities
+    /// (rad/s), so a shift decision is a couple of compares. Plain data, build once.
+    struct FGearbox
+    {
+        std::vector<float> Ratios;
+        // Axle speed above which the gear shifts away from neutral, and under which it shifts back
+        std::vector<float> UpShiftAxleVel;
+        std::vector<float> DownShiftAxleVel;
+
+        int NeutralGear = -1;
+        int FirstForwardGear = -1;
+        int FirstReverseGear = -1;
+        FGearboxSettings Settings;
+
+        bool IsValid() const { return FirstForwardGear >= 0; }
+        bool IsForward(int gear) const { return gear >= 0 && gear < (int)Ratios.size() && Ratios[gear] > 0.0f; }
+        bool IsReverse(int gear) const { return gear >= 0 && gear < (int)Ratios.size() && Ratios[gear] < 0.0f; }
+
+        /// @return gear a stopped vehicle starts in, neutral when there is one
+        int GetStartGear() const { return NeutralGear >= 0 ? NeutralGear : FirstForwardGear; }
+
+        /// @return magnitude of the ratio, direction comes from the track torque transfer
+        float GetRatio(int gear) const
+        {
+            return gear >= 0 && gear < (int)Ratios.size() ? std::fabs(Ratios[gear]) : 0.0f;
+        }
+
+        /// @brief Copy the ratios and find neutral and the first gear of each direction
+        /// @details Shift thresholds fall back to the RPM fractions of settings, call
+        /// BuildShiftTable with the engine torque curve to place them on the torque curve.
+        void Build(const float* ratios, int numRatios, float diferentialRatio, float minRPM, float maxRPM, const FGearboxSettings& settings);
+
+        /// @brief Move the up shift of each gear to where the next gear gives more wheel torque
+        template <typename TorqueType>
+        void BuildShiftTable(float diferentialRatio, float minRPM, float maxRPM, const TorqueType& torqueAtRPM);
+
+        /// @return next gear away from neutral in the direction of gear, gear itself at the last one
+        int NextGear(int gear) const;
+        /// @return next gear towards neutral in the direction of gear, gear itself at the first one
+        int PreviousGear(int gear) const;
+
+    private:
+        void ApplyHysteresis();
+    };
+
+    /// @brief Per vehicle gearbox state
+    struct FGearboxState
+    {
+        int Gear = -1;
+        bool bReverse = false;
+        float TimeSinceShift = 0.0f;
+    };
+
+    inline float axleAngVelFromEngineRPM(float engineRPM, float gearRatio, float diferentialRatio)
+    {
+        float ratio = gearRatio * diferentialRatio;
+        return ratio > Epsilon ? engineRPM * Pi * 2.0f / (60.0f * ratio) : 0.0f;
+    }
+
+    /// @brief Pick the gear for this tick
+    /// @param axleAngVel unsigned axle speed
+    /// @param travelAngVel signed mean track speed, positive forward
+    /// @param driveDirection sign of the requested drive, zero without drive input
+    void updateAutomaticGear(const FGearbox& gearbox, FGearboxState& state, float axleAngVel, float travelAngVel, float driveDirection, float dt);
+
+    template <typename TorqueType>
+    void FGearbox::BuildShiftTable(float diferentialRatio, float minRPM, float maxRPM, const TorqueType& torqueAtRPM)
+    {
+        const int sampleCount = 64;
+
+        for(int gear = 0; gear < (int)Ratios.size(); gear++)
+        {
+            const int next = NextGear(gear);
+            if(next == gear || Ratios[gear] == 0.0f)
+            {
+                continue;
+            }
+
+            const float ratio = GetRatio(gear);
+            const float nextRatio = GetRatio(next);
+
+            // Scan from where the next gear would still run the engine to the fraction based up shift
+            const float begin = axleAngVelFromEngineRPM(minRPM, nextRatio, diferentialRatio);
+            const float end = UpShiftAxleVel[gear];
+            for(int sample = 0; sample <= sampleCount && begin < end; sample++)
+            {
+                const float axleAngVel = begin + (end - begin) * (float)sample / (float)sampleCount;
+                const float torque = torqueAtRPM(fclamp(calculateEngineRPM(axleAngVel, ratio, diferentialRatio), minRPM, maxRPM)) * ratio;
+                const float nextTorque = torqueAtRPM(fclamp(calculateEngineRPM(axleAngVel, nextRatio, diferentialRatio), minRPM, maxRPM)) * nextRatio;
+                if(nextTorque >= torque)
+                {
+                    UpShiftAxleVel[gear] = axleAngVel;
+                    break;
+                }
+            }
+        }
+
+        ApplyHysteresis();
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+#include <cstdint>
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief Sphere sweep of a single suspension unit
+    struct FSweepRequest
+    {
+        FVec3 Start;
+        FVec3 End;
+        float Radius = 0.0f;
+    };
+
+    /// @brief Blocking hit of a sphere sweep (same meaning as FHitResult fields)
+    struct FSweepHit
+    {
+        bool bHit = false;
+        // Sphere center at the time of impact
+        FVec3 Location;
+        FVec3 ImpactPoint;
+        FVec3 ImpactNormal;
+        uint8_t SurfaceType = 0;
+    };
+
+    /// @brief Requests and results of every suspension sweep of a frame
+    struct FSweepBatch
+    {
+        std::vector<FSweepRequest> Requests;
+        std::vector<FSweepHit> Hits;
+
+        int Num() const { return (int)Requests.size(); }
+
+        void Reset(int count)
+        {
+            Requests.resize(count);
+            Hits.resize(count);
+        }
+    };
+
+    /// @brief Sphere sweep against an infinite plane
+    /// @return true on a blocking hit, outHit is left untouched on a miss
+    bool sweepSphereAgainstPlane(const FSweepRequest& request, const FVec3& planePoint, const FVec3& planeNormal, uint8_t surfaceType, FSweepHit& outHit);
+
+    /// @brief Collision backend answering batches of suspension sweeps
+    class IGroundQuery
+    {
+    public:
+        virtual ~IGroundQuery() {}
+
+        /// @brief Sweep every request, hits[i] answers requests[i]
+        virtual void SweepBatch(const FSweepRequest* requests, FSweepHit* hits, int count) = 0;
+
+        void SweepBatch(FSweepBatch& batch)
+        {
+            SweepBatch(batch.Requests.data(), batch.Hits.data(), batch.Num());
+        }
+    };
+
+    /// @brief Infinite plane ground, stand-in for the physics scene in headless runs
+    class FFlatGroundQuery : public IGroundQuery
+    {
+    public:
+        FFlatGroundQuery(const FVec3& planePoint, const FVec3& planeNormal, uint8_t surfaceType = 0);
+
+        virtual void SweepBatch(const FSweepRequest* requests, FSweepHit* hits, int count) override;
+
+    private:
+        FVec3 PlanePoint;
+        FVec3 PlaneNormal;
+        uint8_t SurfaceType;
+    };
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "Core/TrackedGroundQuery.h"
+#include <cstdint>
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief Terrain heights sampled on a regular grid over the XY plane
+    /// @details Sample (x, y) sits at Origin + (x, y) * CellSize with height Origin.Z + Heights[y * NumX + x].
+    /// Heights between samples are bilinear. Plain data, safe to query from any thread.
+    struct FHeightfield
+    {
+        FVec3 Origin;
+        float CellSize = 100.0f;
+        int NumX = 0;
+        int NumY = 0;
+        std::vector<float> Heights;
+        // Per sample, a point takes the surface of its nearest sample. Empty uses DefaultSurfaceType
+        std::vector<uint8_t> SurfaceTypes;
+        uint8_t DefaultSurfaceType = 0;
+
+        bool IsValid() const { return NumX >= 2 && NumY >= 2 && CellSize > Epsilon && (int)Heights.size() == NumX * NumY; }
+
+        /// @brief Sample height(worldX, worldY) at every grid point
+        template <typename HeightType>
+        void Build(const FVec3& origin, float cellSize, int numX, int numY, const HeightType& heightAt)
+        {
+            Origin = origin;
+            CellSize = cellSize;
+            NumX = numX;
+            NumY = numY;
+
+            Heights.resize((size_t)numX * numY);
+            for(int y = 0; y < numY; y++)
+            {
+                for(int x = 0; x < numX; x++)
+                {
+                    Heights[(size_t)y * numX + x] = heightAt(origin.X + x * cellSize, origin.Y + y * cellSize);
+                }
+            }
+        }
+
+        /// @brief Bilinear height and the normal of the bilinear patch at a world position
+        /// @return false outside the grid, outputs are left untouched
+        bool Sample(float worldX, float worldY, float& outHeight, FVec3& outNormal, uint8_t& outSurfaceType) const;
+    };
+
+    /// @brief Sphere sweep against a heightfield
+    /// @details The sphere is swept against the tangent plane of the bilinear patch, which is
+    /// refined at the contact point of the previous plane. Wheels are small against the cells of
+    /// open terrain, a couple of refinements place the contact on the patch under it.
+    /// @return true on a blocking hit, outHit is left untouched on a miss
+    bool sweepSphereAgainstHeightfield(const FSweepRequest& request, const FHeightfield& heightfield, FSweepHit& outHit);
+
+    /// @brief Heightfield ground for headless runs and open terrain, a fraction of the cost of a physics sweep
+    /// @details Sweeps outside the grid miss. Nothing moves on a heightfield, contacts may be reused.
+    class FHeightfieldGroundQuery : public IGroundQuery
+    {
+    public:
+        /// @param heightfield must outlive the query
+        explicit FHeightfieldGroundQuery(const FHeightfield& heightfield);
+
+        virtual void SweepBatch(const FSweepRequest* requests, FSweepHit* hits, int count) override;
+
+    private:
+        const FHeightfield& Heightfield;
+    };
+}
@@ -0,0 +1,210 @@
+#pragma once
+
+#include "Core/TrackedSuspensionStore.h"
+#include <cstdint>
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief Packs values of any bit width into bytes, least significant bit first
+    class FNetBitWriter
+    {
+    public:
+        void Reset()
+        {
+            Bytes.clear();
+            NumBits = 0;
+        }
+
+        void WriteBits(uint32_t value, int bits);
+        void WriteBool(bool value) { WriteBits(value ? 1u : 0u, 1); }
+
+        int GetNumBits() const { return NumBits; }
+        const std::vector<uint8_t>& GetBytes() const { return Bytes; }
+
+    private:
+        std::vector<uint8_t> Bytes;
+        int NumBits = 0;
+    };
+
+    /// @brief Reads what FNetBitWriter wrote
+    class FNetBitReader
+    {
+    public:
+        FNetBitReader(const uint8_t* data, int numBits)
+            : Data(data)
+            , NumBits(numBits)
+        {
+        }
+
+        uint32_t ReadBits(int bits);
+        bool ReadBool() { return ReadBits(1) != 0; }
+
+        /// @return true once a read ran past the end, every read after it returns zero
+        bool IsOverflowed() const { return bOverflow; }
+
+    private:
+        const uint8_t* Data;
+        int NumBits;
+        int Position = 0;
+        bool bOverflow = false;
+    };
+
+    /// @return true when sequence a comes after b, wraps around
+    inline bool isNewerSequence(uint16_t a, uint16_t b)
+    {
+        return (int16_t)(uint16_t)(a - b) > 0;
+    }
+
+    /// @brief Raw track input in [-1, 1] as one byte, zero stays exact, NaN and inf go out as zero
+    inline uint8_t quantizeNetInput(float input)
+    {
+        return (uint8_t)(std::lround(std::isfinite(input) ? fclamp(input, -1.0f, 1.0f) * 127.0f : 0.0f) + 127);
+    }
+
+    inline float dequantizeNetInput(uint8_t value)
+    {
+        return (float)((int)value - 127) / 127.0f;
+    }
+
+    /// @brief Range and resolution of every replicated value
+    struct FNetQuantization
+    {
+        // Track angular velocity (rad/s), symmetric around zero
+        float MaxTrackAngVel = 128.0f;
+        int TrackAngVelBits = 14;
+        float MaxEngineRPM = 8192.0f;
+        int EngineRPMBits = 10;
+        int ThrottleBits = 6;
+        // Raw track inputs in [-1, 1]
+        int InputBits = 7;
+        // Suspension length as a fraction of its maximum, at most 8
+        int SuspensionBits = 6;
+    };
+
+    /// @brief Drivetrain values carried by a snapshot, suspension lengths come from FSuspensionStore
+    struct FNetVehicleState
+    {
+        float TrackLeftAngVel = 0.0f;
+        float TrackRightAngVel = 0.0f;
+        float Throttle = 0.0f;
+        float EngineRPM = 0.0f;
+        float InputLeft = 0.0f;
+        float InputRight = 0.0f;
+        int Gear = -1;
+        bool bReverse = false;
+        bool bAsleep = false;
+    };
+
+    /// @brief Quantized movement state of one vehicle at one server tick
+    struct FVehicleNetSnapshot
+    {
+        uint16_t Sequence = 0;
+        // Last client input the server simulated, the client replays the ones after it
+        uint16_t LastInput = 0;
+
+        uint32_t TrackLeftAngVel = 0;
+        uint32_t TrackRightAngVel = 0;
+        uint32_t Throttle = 0;
+        uint32_t EngineRPM = 0;
+        uint32_t InputLeft = 0;
+        uint32_t InputRight = 0;
+        // Gear index + 1, zero without a gearbox
+        uint32_t Gear = 0;
+        bool bReverse = false;
+        bool bAsleep = false;
+
+        // Per unit, store order
+        std::vector<uint8_t> SuspensionLength;
+
+        /// @return true when everything but the sequence matches
+        bool IsStateEqual(const FVehicleNetSnapshot& other) const;
+    };
+
+    void quantizeNetState(const FNetVehicleState& state, const FSuspensionStore& store, const FNetQuantization& quantization, FVehicleNetSnapshot& outSnapshot);
+
+    /// @brief Unpack a snapshot, suspension lengths go to store.PreviousLength
+    void dequantizeNetState(const FVehicleNetSnapshot& snapshot, const FNetQuantization& quantization, FNetVehicleState& outState, FSuspensionStore& store);
+
+    /// @brief Last received snapshots, the baselines deltas are read against
+    class FNetSnapshotHistory
+    {
+    public:
+        static const int Capacity = 32;
+
+        void Reset();
+        void Add(const FVehicleNetSnapshot& snapshot);
+
+        /// @return snapshot with the sequence, nullptr once it dropped out of the history
+        const FVehicleNetSnapshot* Find(uint16_t sequence) const;
+
+    private:
+        FVehicleNetSnapshot Snapshots[Capacity];
+        bool Valid[Capacity] = {};
+        int Next = 0;
+    };
+
+    // Sequences per full snapshot, bounds how long a receiver that lost its baseline waits
+    const int NetFullSnapshotInterval = 64;
+
+    /// @return true when a snapshot should be sent whole instead of against the baseline
+    inline bool needsFullNetSnapshot(uint16_t sequence, uint16_t baselineSequence)
+    {
+        return sequence / NetFullSnapshotInterval != baselineSequence / NetFullSnapshotInterval;
+    }
+
+    /// @brief Write a snapshot, as a delta when the receiver acknowledged baseline
+    /// @details Values equal to the baseline cost one bit, a vehicle at rest a few bytes.
+    void writeNetSnapshot(FNetBitWriter& writer, const FVehicleNetSnapshot& snapshot, const FVehicleNetSnapshot* baseline, const FNetQuantization& quantization);
+
+    enum class ENetSnapshotRead : uint8_t
+    {
+        Ok,
+        // Delta against a snapshot the receiver never got or already dropped, the next full one recovers
+        MissingBaseline,
+        Corrupt
+    };
+
+    /// @brief Read a snapshot written by writeNetSnapshot
+    /// @details On MissingBaseline the rest of the snapshot is not read and outSnapshot is left as it was.
+    ENetSnapshotRead readNetSnapshot(FNetBitReader& reader, const FNetSnapshotHistory& baselines, const FNetQuantization& quantization, FVehicleNetSnapshot& outSnapshot);
+
+    /// @brief Input of one client frame
+    struct FNetInput
+    {
+        uint16_t Sequence = 0;
+        float Left = 0.0f;
+        float Right = 0.0f;
+        float DeltaTime = 0.0f;
+        // Drivetrain steps the frame ran when it was simulated first, 0 while asleep.
+        // With fixed steps it depends on the time the accumulator carried, not on DeltaTime alone
+        int Steps = 1;
+    };
+
+    /// @brief Inputs the client simulated ahead of the last server snapshot
+    class FNetInputHistory
+    {
+    public:
+        static const int Capacity = 128;
+
+        /// @brief Record an input, the oldest one is dropped when full
+        void Add(const FNetInput& input);
+
+        /// @brief Drop the inputs up to and including sequence
+        void Acknowledge(uint16_t sequence);
+
+        void Reset() { Count = 0; }
+        int Num() const { return Count; }
+
+        /// @return input by age, 0 is the oldest
+        const FNetInput& operator[](int index) const { return Inputs[(First + index) % Capacity]; }
+
+        /// @return last added input, Num() must be above zero
+        FNetInput& Newest() { return Inputs[(First + Count - 1) % Capacity]; }
+
+    private:
+        FNetInput Inputs[Capacity];
+        int First = 0;
+        int Count = 0;
+    };
+}
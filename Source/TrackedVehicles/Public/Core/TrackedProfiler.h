@@ -0,0 +1,133 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief Tick phases reported to the profiler sink
+    enum class EProfileScope : uint8_t
+    {
+        BeginTick,
+        Drivetrain,
+        GatherTraces,
+        ExecuteTraces,
+        ConsumeTraces,
+        SuspensionForces,
+        Friction,
+        ApplyForces,
+        GroundFollow,
+        Count
+    };
+
+    /// @brief Per tick amounts reported to the profiler sink
+    enum class EProfileCounter : uint8_t
+    {
+        Traces,
+        EngagedContacts,
+        ForcesApplied,
+        SleepingVehicles,
+        Count
+    };
+
+    const char* profileScopeName(EProfileScope scope);
+    const char* profileCounterName(EProfileCounter counter);
+
+    /// @brief Receives the scopes and counters of every vehicle
+    /// @details Called from whatever thread runs the phase, implementations must be thread safe.
+    class IProfilerSink
+    {
+    public:
+        virtual ~IProfilerSink() {}
+
+        virtual void BeginScope(EProfileScope scope) = 0;
+        virtual void EndScope(EProfileScope scope) = 0;
+        virtual void AddCounter(EProfileCounter counter, int64_t value) = 0;
+    };
+
+    /// @brief Route the hooks to sink, nullptr turns them off (the default)
+    /// @details Without a sink a hook costs one atomic load.
+    void setProfilerSink(IProfilerSink* sink);
+    IProfilerSink* getProfilerSink();
+
+    /// @brief Reports the enclosing block as scope
+    class FProfileScope
+    {
+    public:
+        explicit FProfileScope(EProfileScope scope)
+            : Sink(getProfilerSink())
+            , Scope(scope)
+        {
+            if(Sink)
+            {
+                Sink->BeginScope(Scope);
+            }
+        }
+
+        ~FProfileScope()
+        {
+            if(Sink)
+            {
+                Sink->EndScope(Scope);
+            }
+        }
+
+        FProfileScope(const FProfileScope&) = delete;
+        FProfileScope& operator=(const FProfileScope&) = delete;
+
+    private:
+        IProfilerSink* Sink;
+        EProfileScope Scope;
+    };
+
+    inline void profileCounter(EProfileCounter counter, int64_t value)
+    {
+        if(IProfilerSink* sink = getProfilerSink())
+        {
+            sink->AddCounter(counter, value);
+        }
+    }
+
+    /// @brief Records scopes and counters as Chrome trace events (chrome://tracing, Perfetto)
+    class FChromeTraceWriter : public IProfilerSink
+    {
+    public:
+        FChromeTraceWriter();
+
+        virtual void BeginScope(EProfileScope scope) override;
+        virtual void EndScope(EProfileScope scope) override;
+        virtual void AddCounter(EProfileCounter counter, int64_t value) override;
+
+        int NumEvents() const;
+
+        /// @brief Write the recorded events as a JSON trace file
+        /// @return false when the file cannot be written
+        bool Write(const char* path) const;
+
+    private:
+        struct FEvent
+        {
+            // 'B', 'E' or 'C'
+            char Phase;
+            uint8_t Id;
+            uint32_t Thread;
+            int64_t TimeNs;
+            int64_t Value;
+        };
+
+        void Record(char phase, uint8_t id, int64_t value);
+
+        std::chrono::steady_clock::time_point Start;
+        mutable std::mutex Mutex;
+        std::vector<FEvent> Events;
+    };
+}
+
+#define TRACKEDCORE_PROFILE_CONCAT_INNER(a, b) a##b
+#define TRACKEDCORE_PROFILE_CONCAT(a, b) TRACKEDCORE_PROFILE_CONCAT_INNER(a, b)
+
+/// Report the rest of the enclosing block as TrackedCore::EProfileScope::Name
+#define TRACKEDCORE_PROFILE_SCOPE(Name) \
+    TrackedCore::FProfileScope TRACKEDCORE_PROFILE_CONCAT(TrackedProfileScope, __LINE__)(TrackedCore::EProfileScope::Name)
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "Core/TrackedVehicleSimulation.h"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief Everything a headless replay needs to rebuild a vehicle
+    struct FReplayVehicleSetup
+    {
+        struct FUnit
+        {
+            ETrackSide Side = ETrackSide::Left;
+            FSuspensionUnitSetup Setup;
+        };
+
+        // Gearbox and EngineTorque pointers are ignored, the tables below replace them
+        FDrivetrainParams Params;
+        FGearbox Gearbox;
+        FCurveTable EngineTorque;
+        FSurfaceTable Surfaces;
+        float FrictionSprocketRadiusCm = 24.05f;
+        int ReducedStride = 2;
+        std::vector<FUnit> Units;
+    };
+
+    /// @brief Fill a setup from the simulation pieces, shared by the component and the core vehicle
+    void captureReplayVehicleSetup(const FDrivetrainParams& params, const FGearbox* gearbox, const FCurveTable* engineTorque,
+        const FSurfaceTable& surfaces, float frictionSprocketRadiusCm, int reducedStride, const FSuspensionStore& store, FReplayVehicleSetup& outSetup);
+
+    /// @brief Rebuild a core vehicle, its Params point into setup which must outlive it
+    void applyReplayVehicleSetup(const FReplayVehicleSetup& setup, FVehicleSimulation& outVehicle);
+
+    /// @brief Per tick values checked after a replayed tick, compared bit for bit
+    struct FReplayVehicleState
+    {
+        float TrackLeftAngVel = 0.0f;
+        float TrackRightAngVel = 0.0f;
+        float EngineRPM = 0.0f;
+        FVec3 Force;
+        FVec3 Torque;
+
+        bool IsBitEqual(const FReplayVehicleState& other) const;
+    };
+
+    FReplayVehicleState captureReplayVehicleState(const FVehicleSimulation& vehicle);
+
+    /// @brief One tick of one vehicle
+    struct FReplayVehicleTick
+    {
+        uint32_t VehicleId = 0;
+        float DeltaTime = 0.0f;
+        float RawLeftTorque = 0.0f;
+        float RawRightTorque = 0.0f;
+        ESimulationLod Lod = ESimulationLod::Full;
+        // Body as the tick read it
+        FVehicleFrame Frame;
+        // One per traced unit, after contact reuse
+        const FSweepHit* Hits = nullptr;
+        int NumHits = 0;
+        // Optional, written by recorders that run the core pipeline
+        bool bHasState = false;
+        FReplayVehicleState State;
+    };
+
+    /// @brief Streams a replay log to disk
+    /// @details Layout, little endian: "TVRL", uint32 version, then chunks of uint8 type,
+    /// uint32 payload size, payload. 'V' defines a vehicle, 'T' is one tick of one vehicle.
+    /// Ticks are replayed in file order, so vehicles ticked separately interleave freely.
+    /// Not thread safe, write from one thread.
+    class FReplayLogWriter
+    {
+    public:
+        static const uint32_t Version = 1;
+
+        ~FReplayLogWriter();
+
+        bool Open(const char* path);
+        /// @return false when a write failed since Open
+        bool Close();
+        bool IsOpen() const { return File != nullptr; }
+
+        void WriteVehicle(uint32_t vehicleId, const FReplayVehicleSetup& setup);
+        void WriteTick(const FReplayVehicleTick& tick);
+
+    private:
+        void FlushChunk(uint8_t type);
+
+        FILE* File = nullptr;
+        bool bFailed = false;
+        std::vector<uint8_t> Chunk;
+    };
+
+    /// @brief Read only memory mapping of a replay log
+    class FReplayLogFile
+    {
+    public:
+        FReplayLogFile() {}
+        ~FReplayLogFile();
+
+        FReplayLogFile(const FReplayLogFile&) = delete;
+        FReplayLogFile& operator=(const FReplayLogFile&) = delete;
+
+        /// @return false when the file cannot be mapped or is not a replay log of this version
+        bool Open(const char* path);
+        void Close();
+
+        const uint8_t* GetData() const { return Data; }
+        size_t GetSize() const { return Size; }
+
+    private:
+        const uint8_t* Data = nullptr;
+        size_t Size = 0;
+#if defined(_WIN32)
+        void* FileHandle = nullptr;
+        void* MappingHandle = nullptr;
+#endif
+    };
+
+    /// @brief Walks the chunks of a mapped log in file order
+    class FReplayLogReader
+    {
+    public:
+        enum class EChunk : uint8_t
+        {
+            End,
+            Vehicle,
+            Tick,
+            Corrupt
+        };
+
+        explicit FReplayLogReader(const FReplayLogFile& file);
+
+        /// @brief Decode the next chunk into outSetup or outTick, unknown chunks are skipped
+        /// @details outTick.Hits points into a buffer of the reader, valid until the next call.
+        EChunk Next(uint32_t& outVehicleId, FReplayVehicleSetup& outSetup, FReplayVehicleTick& outTick);
+
+        /// @brief Back to the first chunk
+        void Rewind();
+
+    private:
+        const uint8_t* Begin;
+        const uint8_t* End;
+        const uint8_t* Cursor;
+        std::vector<FSweepHit> Hits;
+    };
+
+    /// @brief Answers sweeps with the hits of a recorded tick
+    class FReplayGroundQuery : public IGroundQuery
+    {
+    public:
+        void SetHits(const FSweepHit* hits, int numHits)
+        {
+            Hits = hits;
+            NumHits = numHits;
+        }
+
+        /// @return sweeps of the last batches that had no recorded hit, a replay that diverged
+        int GetNumMissing() const { return NumMissing; }
+
+        virtual void SweepBatch(const FSweepRequest* requests, FSweepHit* hits, int count) override;
+
+    private:
+        const FSweepHit* Hits = nullptr;
+        int NumHits = 0;
+        int NumMissing = 0;
+    };
+
+    /// @brief Feed the inputs, body and hits of a recorded tick through simulateVehicleTick
+    /// @return false when the recorded state does not match the replayed one bit for bit
+    bool replayVehicleTick(FVehicleSimulation& vehicle, int reducedStride, const FReplayVehicleTick& tick, FReplayGroundQuery& ground);
+}
@@ -0,0 +1,136 @@
+#pragma once
+
+#include "Core/TrackedSuspensionStore.h"
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief How much of the vehicle is simulated this tick
+    enum class ESimulationLod : uint8_t
+    {
+        // Every suspension unit traced, full forces and friction
+        Full,
+        // Representative units traced, the rest interpolated between them
+        Reduced,
+        // Physics off, hull follows the ground under the corner units
+        Kinematic
+    };
+
+    /// @brief Distance thresholds of the simulation LOD
+    struct FSimulationLodSettings
+    {
+        float ReducedDistance = 5000.0f;
+        float KinematicDistance = 15000.0f;
+        // LOD only drops back once the distance is this much under the threshold
+        float Hysteresis = 500.0f;
+        // Reduced LOD traces every ReducedStride-th unit of a side (plus the last one)
+        int ReducedStride = 2;
+    };
+
+    /// @return LOD for the distance to the closest viewer
+    inline ESimulationLod selectSimulationLod(float viewerDistance, ESimulationLod current, const FSimulationLodSettings& settings)
+    {
+        float reducedDistance = settings.ReducedDistance;
+        float kinematicDistance = settings.KinematicDistance;
+
+        // Going back to a finer LOD needs to get closer than the threshold
+        if(current == ESimulationLod::Reduced || current == ESimulationLod::Kinematic)
+        {
+            reducedDistance -= settings.Hysteresis;
+        }
+        if(current == ESimulationLod::Kinematic)
+        {
+            kinematicDistance -= settings.Hysteresis;
+        }
+
+        if(viewerDistance >= kinematicDistance)
+        {
+            return ESimulationLod::Kinematic;
+        }
+        if(viewerDistance >= reducedDistance)
+        {
+            return ESimulationLod::Reduced;
+        }
+        return ESimulationLod::Full;
+    }
+
+    /// @brief Counts how long the vehicle stays at rest before putting it to sleep
+    struct FSleepTimer
+    {
+        float Timer = 0.0f;
+        bool bAsleep = false;
+
+        /// @return true on the tick the vehicle falls asleep
+        bool Update(bool atRest, float sleepSeconds, float deltaTime)
+        {
+            if(!atRest)
+            {
+                Wake();
+                return false;
+            }
+
+            if(bAsleep)
+            {
+                return false;
+            }
+
+            Timer += deltaTime;
+            bAsleep = Timer >= sleepSeconds;
+            return bAsleep;
+        }
+
+        void Wake()
+        {
+            Timer = 0.0f;
+            bAsleep = false;
+        }
+    };
+
+    /// @brief At rest when hull and both tracks are slower than sleepVelocity (cm/s)
+    inline bool isVehicleAtRest(const FVec3& linearVelocity, const FVec3& angularVelocity, float trackLinVelLeft, float trackLinVelRight, float sleepVelocity)
+    {
+        // angular velocity in rad/s, compared as the speed of a point one meter away
+        return linearVelocity.Size() < sleepVelocity
+            && angularVelocity.Size() * M2CM < sleepVelocity
+            && std::fabs(trackLinVelLeft) < sleepVelocity
+            && std::fabs(trackLinVelRight) < sleepVelocity;
+    }
+
+    /// @brief Units of a suspension store traced at the current LOD, in store order
+    /// @details Plain struct so engine classes can hold the storage the core functions fill.
+    struct FTracedUnits
+    {
+        std::vector<int> Units;
+
+        int Num() const { return (int)Units.size(); }
+        int operator[](int trace) const { return Units[trace]; }
+    };
+
+    /// @brief Units to trace for the LOD, in store order
+    /// @details Reduced keeps every stride-th unit and the last one of each side,
+    /// Kinematic only the first and the last one of each side.
+    void selectTracedUnits(const FSuspensionStore& store, ESimulationLod lod, int reducedStride, std::vector<int>& outUnits);
+
+    /// @brief Fill the untraced units of each side from the traced ones around them
+    /// @details NewLength is interpolated along the side, contact data comes from
+    /// the closer traced unit. Expects WorldLocation and WorldUp of every unit.
+    void interpolateSkippedUnits(FSuspensionStore& store, const std::vector<int>& tracedUnits);
+
+    /// @brief Hull correction putting the engaged units back to their ride length
+    struct FGroundFollow
+    {
+        bool bValid = false;
+        // Along the hull up axis, negative moves the hull down
+        float HeightOffset = 0.0f;
+        // Rise of the ground in front of/right of the hull, radians
+        float PitchAngle = 0.0f;
+        float RollAngle = 0.0f;
+    };
+
+    /// @brief Least squares plane through the ride length error of engaged units
+    /// @param rideRatio rest length of a unit as a fraction of its Length
+    FGroundFollow fitGroundFollow(const FSuspensionStore& store, float rideRatio);
+
+    /// @brief Distance between the left and right track centers
+    float calculateTrackWidth(const FSuspensionStore& store);
+}
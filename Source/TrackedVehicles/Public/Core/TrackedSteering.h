@@ -0,0 +1,37 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+
+namespace TrackedCore
+{
+    /// @brief Tuning of the skid steer input mapping
+    struct FSkidSteerSettings
+    {
+        // Track inputs under this magnitude count as released
+        float DeadZone = 0.05f;
+        // Brake on the slower track of a turn when it gets no drive at all, scaled down as it gets more
+        float InnerTrackBrake = 0.5f;
+        // Track speed (rad/s) above which a drive against the spin brakes the track first
+        float CounterSpinAngVel = 1.0f;
+    };
+
+    /// @brief Drive coefficients and brakes resolved from the two track inputs
+    struct FSkidSteerCommand
+    {
+        float WheelLeftCoefficient = 0.0f;
+        float WheelRightCoefficient = 0.0f;
+        float WheelForwardCoefficient = 0.0f;
+        float BrakeRatioLeft = 0.0f;
+        float BrakeRatioRight = 0.0f;
+    };
+
+    /// @brief Map the left and right track inputs, [-1, 1] each, onto the drivetrain
+    /// @details The common part of both inputs becomes the forward coefficient and the rest
+    /// the per track coefficients, so each track gets the torque transfer it asked for.
+    /// - both released: full brake on both tracks
+    /// - one released (pivot turn): full brake on the released track
+    /// - opposite inputs (neutral steer): tracks counter-rotate, no brake
+    /// - same direction, different amounts: the slower (inner) track is partly braked
+    /// - input against the current spin of a track: that track brakes before it reverses
+    FSkidSteerCommand mapSkidSteerInput(float leftInput, float rightInput, float trackLeftAngVel, float trackRightAngVel, const FSkidSteerSettings& settings);
+}
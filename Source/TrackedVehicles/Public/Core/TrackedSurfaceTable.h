@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+#include <cstdint>
+
+namespace TrackedCore
+{
+    /// @brief Ground response of one physical surface type
+    struct FSurfaceParams
+    {
+        float MuXStatic = 1.0f;
+        float MuYStatic = 1.0f;
+        float MuXKinetic = 1.0f;
+        float MuYKinetic = 1.0f;
+        float RollingFrictionCoef = 0.02f;
+        // How deep the wheels sink below the swept contact (cm)
+        float SinkDepth = 0.0f;
+    };
+
+    /// @brief Surface parameters indexed by the surface type of a contact (EPhysicalSurface)
+    /// @details Flat array resolved once per contact, the hot loops never touch
+    /// physical materials.
+    struct FSurfaceTable
+    {
+        // SurfaceType_Default plus SurfaceType1..SurfaceType62, the last slot is SurfaceType_Max
+        static const int NumSurfaces = 64;
+
+        FSurfaceParams Surfaces[NumSurfaces];
+
+        /// @brief Surface type 0 (default) answers out of range types
+        const FSurfaceParams& Get(uint8_t surfaceType) const
+        {
+            return Surfaces[surfaceType < NumSurfaces ? surfaceType : 0];
+        }
+
+        void Set(uint8_t surfaceType, const FSurfaceParams& params)
+        {
+            if(surfaceType < NumSurfaces)
+            {
+                Surfaces[surfaceType] = params;
+            }
+        }
+
+        void Fill(const FSurfaceParams& params)
+        {
+            for(FSurfaceParams& surface : Surfaces)
+            {
+                surface = params;
+            }
+        }
+    };
+
+    /// @brief Suspension length on a surface, the wheel sinks but never beyond full extension
+    inline float applySinkDepth(float sweptLength, float maxLength, const FSurfaceParams& surface)
+    {
+        float length = sweptLength + surface.SinkDepth;
+        return length < maxLength ? length : maxLength;
+    }
+}
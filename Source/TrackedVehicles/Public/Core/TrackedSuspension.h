@@ -0,0 +1,20 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+
+namespace TrackedCore
+{
+    /// @brief Spring and damper force magnitude of a single suspension unit
+    /// @param length rest (maximum) length of the suspension
+    /// @param newLength length measured by the trace this tick
+    /// @param previousLength length of the previous tick
+    /// @param targetVelocity desired suspension velocity (damper reference)
+    float calculateSuspensionForceMagnitude(
+        float length,
+        float newLength,
+        float previousLength,
+        float stiffness,
+        float damping,
+        float targetVelocity,
+        float dt);
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+
+// Lane width of the batched suspension kernel picked at compile time
+#if defined(__AVX2__)
+    #define TRACKEDCORE_SIMD_AVX2 1
+    #define TRACKEDCORE_SIMD_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define TRACKEDCORE_SIMD_SSE2 1
+    #define TRACKEDCORE_SIMD_WIDTH 4
+#else
+    #define TRACKEDCORE_SIMD_WIDTH 1
+#endif
+
+namespace TrackedCore
+{
+    /// @brief Spring and damper force magnitudes of many suspension units at once
+    /// @details Same math and operation order as calculateSuspensionForceMagnitude
+    /// (no fused multiply-add), so every lane matches the scalar path bit for bit.
+    /// Arrays may span several vehicles as long as they share targetVelocity and dt.
+    void calculateSuspensionForceMagnitudes(
+        const float* length,
+        const float* newLength,
+        const float* previousLength,
+        const float* stiffness,
+        const float* damping,
+        float targetVelocity,
+        float dt,
+        float* outForceMagnitude,
+        int count);
+
+    /// @brief Scalar reference of calculateSuspensionForceMagnitudes
+    void calculateSuspensionForceMagnitudesScalar(
+        const float* length,
+        const float* newLength,
+        const float* previousLength,
+        const float* stiffness,
+        const float* damping,
+        float targetVelocity,
+        float dt,
+        float* outForceMagnitude,
+        int count);
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+#include <cstdint>
+#include <vector>
+
+namespace TrackedCore
+{
+    enum class ETrackSide : uint8_t
+    {
+        Left,
+        Right
+    };
+
+    /// @brief Construction data of a single suspension unit
+    struct FSuspensionUnitSetup
+    {
+        FVec3 RootLocation;
+        FQuat4 RootRotation;
+        float Length = 100.0f;
+        float Radius = 100.0f;
+        float Stiffness = 0.5f;
+        float Damping = 0.5f;
+    };
+
+    /// @brief Structure-of-arrays state of every suspension unit of a vehicle
+    /// @details Both tracks share the arrays: left units occupy [0, LeftCount),
+    /// right units occupy [LeftCount, Num()). Left units must be added first.
+    struct FSuspensionStore
+    {
+        int LeftCount = 0;
+
+        // Static setup (actor space)
+        std::vector<FVec3> RootLocation;
+        std::vector<FQuat4> RootRotation;
+        // Axes of RootRotation, precomputed when the unit is added
+        std::vector<FVec3> LocalUp;
+        std::vector<FVec3> LocalForward;
+        std::vector<FVec3> LocalRight;
+        std::vector<float> Length;
+        std::vector<float> Radius;
+        std::vector<float> Stiffness;
+        std::vector<float> Damping;
+
+        // Per tick state
+        std::vector<float> PreviousLength;
+        std::vector<float> NewLength;
+        std::vector<float> ForceMagnitude;
+        std::vector<FVec3> WorldLocation;
+        std::vector<FVec3> WorldUp;
+        std::vector<FVec3> Force;
+        std::vector<FVec3> ContactPoint;
+        std::vector<FVec3> ContactNormal;
+        std::vector<uint8_t> Engaged;
+        std::vector<uint8_t> HitMaterial;
+
+        int Num() const { return (int)Length.size(); }
+        int SideBegin(ETrackSide side) const { return side == ETrackSide::Left ? 0 : LeftCount; }
+        int SideEnd(ETrackSide side) const { return side == ETrackSide::Left ? LeftCount : Num(); }
+        ETrackSide SideOf(int index) const { return index < LeftCount ? ETrackSide::Left : ETrackSide::Right; }
+
+        void Reserve(int count);
+        void Reset();
+        /// @brief Put every unit back at rest with full length, setup is kept
+        void ResetState();
+
+        /// @return index of the new unit
+        int Add(ETrackSide side, const FSuspensionUnitSetup& setup);
+    };
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "Core/TrackedSuspensionStore.h"
+#include <vector>
+
+namespace TrackedCore
+{
+    /// @brief Closed track loop in hull space, resampled by arc length
+    /// @details Control points and tangents follow USplineComponent: a cubic Hermite segment
+    /// between each pair of consecutive points, the last point connects back to the first.
+    /// Every segment keeps SamplesPerSegment + 1 samples at uniform arc length, so a distance
+    /// along the track maps to a location without solving the curve. The loop lies in the
+    /// hull XZ plane of its side. Plain data, safe to sample from any thread.
+    ///
+    /// Distances along the loop are measured at Build. A segment re-solved after its points
+    /// moved keeps its share of the loop and stretches it, so links elsewhere stay in place.
+    struct FTrackPath
+    {
+        int SamplesPerSegment = 16;
+        // +1 when the loop runs forward along its top, the outward normal flips otherwise
+        float Winding = 1.0f;
+
+        std::vector<FVec3> Points;
+        std::vector<FVec3> Tangents;
+
+        // Current arc length of each segment
+        std::vector<float> SegmentLength;
+        // Where each segment starts on the loop as built, NumSegments + 1 entries
+        std::vector<float> SegmentStart;
+
+        // SamplesPerSegment + 1 entries per segment
+        std::vector<FVec3> Location;
+        std::vector<FVec3> Direction;
+
+        int NumSegments() const { return (int)Points.size(); }
+        bool IsValid() const { return Points.size() >= 2 && GetLength() > Epsilon; }
+        float GetLength() const { return SegmentStart.empty() ? 0.0f : SegmentStart.back(); }
+
+        /// @brief Copy the control points and resample every segment
+        /// @param tangents one per point, nullptr derives Catmull-Rom tangents from the neighbours
+        void Build(const FVec3* points, const FVec3* tangents, int numPoints, int samplesPerSegment);
+
+        /// @brief Resample one segment from the current control points
+        void SolveSegment(int segment);
+
+        /// @brief Location and unit direction at distance along the loop, wraps around
+        void Sample(float distance, FVec3& outLocation, FVec3& outDirection) const;
+
+        /// @brief Unit normal pointing away from the wheels for a direction on the loop
+        FVec3 OutwardNormal(const FVec3& direction) const
+        {
+            return safeNormal(cross(direction, FVec3(0.0f, 1.0f, 0.0f)) * Winding);
+        }
+
+        /// @brief Sample at localDistance from the start of one segment, no wrapping
+        void SampleSegment(int segment, float localDistance, FVec3& outLocation, FVec3& outDirection) const;
+    };
+
+    /// @brief Consecutive items of a loop, may wrap past the last one
+    struct FTrackLoopRange
+    {
+        int First = 0;
+        int Count = 0;
+
+        FTrackLoopRange() {}
+        FTrackLoopRange(int first, int count) : First(first), Count(count) {}
+
+        bool IsEmpty() const { return Count == 0; }
+    };
+
+    /// @brief Control points of a track loop that ride on suspension units
+    struct FTrackPathBinding
+    {
+        // Per control point
+        std::vector<FVec3> RestPoints;
+        std::vector<int> Unit;
+        std::vector<float> AuthoredLength;
+        std::vector<float> AppliedLength;
+
+        // Per segment, scratch of updateTrackPath
+        std::vector<uint8_t> DirtySegments;
+
+        bool IsBound() const;
+    };
+
+    /// @brief Bind every control point under a wheel of the side to its suspension unit
+    /// @details A point is bound to the closest wheel whose rim it lies on (below the axle),
+    /// the others stay fixed to the hull.
+    /// @param authoredLengthRatio suspension length, as a fraction of its maximum, the loop was authored at
+    void bindTrackPath(const FTrackPath& path, const FSuspensionStore& store, ETrackSide side, float authoredLengthRatio, FTrackPathBinding& outBinding);
+
+    /// @brief Move bound points to the current suspension lengths and re-solve only the segments next to them
+    /// @details Points whose unit moved less than epsilon since their last solve are left alone.
+    /// @return re-solved segments, empty when nothing moved
+    FTrackLoopRange updateTrackPath(FTrackPath& path, FTrackPathBinding& binding, const FSuspensionStore& store, float epsilon);
+
+    /// @return links of an evenly spaced loop starting at phase that lie on the given segments
+    FTrackLoopRange linksOnSegments(const FTrackPath& path, float phase, int numLinks, const FTrackLoopRange& segments);
+
+    /// @brief Hull space transform of one track link
+    struct FTrackLinkTransform
+    {
+        FVec3 Location;
+        FQuat4 Rotation;
+    };
+
+    /// @brief Place links of numLinks evenly spaced links on the loop, the first one at phase
+    /// @details Links are X forward along the track and Z outward, lifted by outwardOffset.
+    /// outLinks receives links.Count transforms, links.First first. Walks the segments once in
+    /// distance order instead of searching per link.
+    void placeTrackLinks(const FTrackPath& path, float phase, int numLinks, float outwardOffset, const FTrackLoopRange& links, FTrackLinkTransform* outLinks);
+}
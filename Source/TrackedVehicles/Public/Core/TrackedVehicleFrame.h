@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Core/TrackedCoreMath.h"
+
+namespace TrackedCore
+{
+    /// @brief Snapshot of the vehicle body taken once per tick
+    /// @details Every suspension unit and contact of the tick reads the same frame
+    /// instead of querying the actor transform and the physics body again.
+    struct FVehicleFrame
+    {
+        FVec3 Location;
+        FQuat4 Rotation;
+        FVec3 Scale = FVec3(1.0f, 1.0f, 1.0f);
+
+        // World space basis of the vehicle
+        FVec3 Forward = FVec3(1.0f, 0.0f, 0.0f);
+        FVec3 Right = FVec3(0.0f, 1.0f, 0.0f);
+        FVec3 Up = FVec3(0.0f, 0.0f, 1.0f);
+
+        // Physics body state (world space, angular velocity in radians)
+        FVec3 LinearVelocity;
+        FVec3 AngularVelocity;
+        FVec3 CenterOfMass;
+        float Mass = 0.0f;
+
+        /// @brief Refresh the basis after Rotation changed
+        void UpdateBasis()
+        {
+            Forward = rotateVector(Rotation, FVec3(1.0f, 0.0f, 0.0f));
+            Right = rotateVector(Rotation, FVec3(0.0f, 1.0f, 0.0f));
+            Up = rotateVector(Rotation, FVec3(0.0f, 0.0f, 1.0f));
+        }
+
+        // Same as FTransform::TransformVectorNoScale
+        FVec3 TransformDirection(const FVec3& direction) const
+        {
+            return rotateVector(Rotation, direction);
+        }
+
+        // Same as FTransform::TransformPosition
+        FVec3 TransformLocation(const FVec3& location) const
+        {
+            return Location + rotateVector(Rotation, FVec3(location.X * Scale.X, location.Y * Scale.Y, location.Z * Scale.Z));
+        }
+
+        /// @brief Velocity of a point rigidly attached to the body
+        FVec3 VelocityAtLocation(const FVec3& worldLocation) const
+        {
+            return LinearVelocity + cross(AngularVelocity, worldLocation - CenterOfMass);
+        }
+    };
+}
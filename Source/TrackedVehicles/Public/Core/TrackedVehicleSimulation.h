@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Core/TrackedContactCache.h"
+#include "Core/TrackedCurveTable.h"
+#include "Core/TrackedDrivetrain.h"
+#include "Core/TrackedForceAccumulator.h"
+#include "Core/TrackedFriction.h"
+#include "Core/TrackedGearbox.h"
+#include "Core/TrackedGroundQuery.h"
+#include "Core/TrackedSimulationLod.h"
+#include "Core/TrackedSteering.h"
+#include "Core/TrackedSuspensionStore.h"
+#include "Core/TrackedVehicleFrame.h"
+
+namespace TrackedCore
+{
+    /// @brief Tuning of the drivetrain (mirrors UTrackedMovementComponent properties)
+    struct FDrivetrainParams
+    {
+        float MomentInertia = 0.0f;
+        float SprocketRadiusCm = 24.05f;
+        float BrakeForce = 30.0f;
+        float DiferentialRatio = 3.5f;
+        float TransmissionEfficiency = 0.9f;
+        // Drive torque multiplier on top of the engine curve
+        float EngineExtraPowerRatio = 3.0f;
+        // Ratio used without a gearbox
+        float GearRatio = 1.0f;
+        // Gear ratios and shift table, shared by vehicles of the same kind
+        const FGearbox* Gearbox = nullptr;
+        bool bAutoGearBox = true;
+        float SuspTargetVelocity = 0.0f;
+        // Engine torque (cm units) by RPM
+        const FCurveTable* EngineTorque = nullptr;
+        FSkidSteerSettings SkidSteer;
+    };
+
+    /// @brief Per tick drivetrain state (mirrors UTrackedMovementComponent transient state)
+    struct FDrivetrainState
+    {
+        // Track inputs in [-1, 1], mapped by prepareInputAxis
+        float RawLeftTorque = 0.0f;
+        float RawRightTorque = 0.0f;
+
+        // Inputs
+        float WheelLeftCoefficient = 0.0f;
+        float WheelRightCoefficient = 0.0f;
+        float WheelForwardCoefficient = 0.0f;
+        float BrakeRatioLeft = 0.0f;
+        float BrakeRatioRight = 0.0f;
+
+        float TrackTorqueTransferLeft = 0.0f;
+        float TrackTorqueTransferRight = 0.0f;
+        float Throttle = 0.0f;
+        float ThrottleIncrement = 0.0f;
+        float DriveLeftTorque = 0.0f;
+        float DriveRightTorque = 0.0f;
+        float TrackFrictionTorqueLeft = 0.0f;
+        float TrackFrictionTorqueRight = 0.0f;
+        float TrackRollingFrictionTorqueLeft = 0.0f;
+        float TrackRollingFrictionTorqueRight = 0.0f;
+        float TrackLeftTorque = 0.0f;
+        float TrackRightTorque = 0.0f;
+        float TrackLeftAngVel = 0.0f;
+        float TrackRightAngVel = 0.0f;
+        float TrackLeftLinVel = 0.0f;
+        float TrackRightLinVel = 0.0f;
+        float AxleAngVel = 0.0f;
+        float EngineRPM = 0.0f;
+        float EngineTorque = 0.0f;
+        float DriveAxleTorque = 0.0f;
+        FGearboxState Gearbox;
+    };
+
+    /// @brief Everything one vehicle needs for a headless tick
+    struct FVehicleSimulation
+    {
+        FDrivetrainParams Params;
+        FDrivetrainState Drivetrain;
+        FVehicleFrame Frame;
+        FSuspensionStore Suspensions;
+        FSweepBatch Traces;
+        FForceAccumulator BodyForces;
+        FTrackFrictionParams Friction;
+        // Friction.Surfaces points here while the tick runs
+        FSurfaceTable Surfaces;
+        FFrictionContactBatch FrictionContacts;
+        // Units traced this tick, set by setSimulationLod
+        ESimulationLod Lod = ESimulationLod::Full;
+        std::vector<int> TracedUnits;
+        // Reuse of last tick contacts, sized by setSimulationLod
+        bool bReuseContacts = false;
+        FContactCacheSettings ContactReuse;
+        FContactCache ContactCache;
+        // Downward acceleration carried by a Kinematic hull (cm/s^2)
+        float GravityCm = StandardGravityCm;
+        int NumContacts = 0;
+        // Sweeps sent to the ground backend on the last tick
+        int NumSweeps = 0;
+    };
+
+    // Phases in TickComponent order. UTrackedMovementComponent runs the same functions
+    // on its own state, FVehicleSimulation only bundles it for headless ticks.
+
+    /// @brief Resolve the raw track inputs into drive coefficients and brakes
+    void prepareInputAxis(FDrivetrainState& state, const FDrivetrainParams& params);
+    void updateThrottle(FDrivetrainState& state, float dt);
+    void updateWheelsVelocity(FDrivetrainState& state, const FDrivetrainParams& params, float dt);
+    void updateAxleVelocity(FDrivetrainState& state);
+
+    /// @return ratio of the engaged gear, after the automatic gearbox had its say
+    float updateGear(FDrivetrainState& state, const FDrivetrainParams& params, float dt);
+
+    /// @brief Drive torque of each track from the engine torque through gearRatio
+    void updateDriveTorque(FDrivetrainState& state, const FDrivetrainParams& params, float gearRatio);
+
+    /// @brief Gear, engine RPM and torque, then the drive torque of each track
+    /// @details engineTorque answers Clamp(rpm) and Evaluate(rpm) like FCurveTable,
+    /// the engine gives no torque without it.
+    template <typename TorqueType>
+    void updateEngineAndDrive(FDrivetrainState& state, const FDrivetrainParams& params, float dt, const TorqueType* engineTorque);
+
+    /// @brief updateEngineAndDrive with the baked params.EngineTorque table
+    void updateEngineAndDrive(FDrivetrainState& state, const FDrivetrainParams& params, float dt);
+    void simulateDrivetrainStep(FDrivetrainState& state, const FDrivetrainParams& params, float dt);
+
+    /// @brief Switch LOD and select its traced units, call it once the suspension store is built
+    void setSimulationLod(FVehicleSimulation& vehicle, ESimulationLod lod, int reducedStride);
+
+    /// @brief World pose of every unit, sweeps of the traced ones into outTraces
+    void gatherSuspensionTraces(FSuspensionStore& suspensions, const FVehicleFrame& frame, const std::vector<int>& tracedUnits, FSweepBatch& outTraces);
+
+    /// @brief Contacts of the swept units, untraced units interpolated between them
+    /// @return number of engaged units
+    int consumeSuspensionTraces(FSuspensionStore& suspensions, const FSweepBatch& traces, const std::vector<int>& tracedUnits, const FSurfaceTable& surfaces);
+
+    /// @brief Spring and damper force of every unit, engaged ones pushed into bodyForces
+    /// @details A Kinematic hull only takes the new lengths, no force is applied.
+    void evaluateSuspensionForces(FSuspensionStore& suspensions, ESimulationLod lod, float targetVelocity, float dt, FForceAccumulator& bodyForces);
+
+    /// @brief Friction and rolling friction torques of both tracks, contact forces into bodyForces
+    /// @details Contacts are solved in one batch. A Kinematic hull has no contacts to solve,
+    /// its tracks roll without slip and carry half the hull mass each under gravityCm (cm/s^2).
+    void updateTrackFriction(
+        FDrivetrainState& state,
+        const FDrivetrainParams& drivetrain,
+        ESimulationLod lod,
+        const FSuspensionStore& suspensions,
+        const FVehicleFrame& frame,
+        const FTrackFrictionParams& friction,
+        float gravityCm,
+        float dt,
+        FFrictionContactBatch& contacts,
+        FForceAccumulator& bodyForces);
+
+    /// @brief Full tick of one vehicle against a ground backend
+    void simulateVehicleTick(FVehicleSimulation& vehicle, IGroundQuery& ground, float dt);
+
+    template <typename TorqueType>
+    void updateEngineAndDrive(FDrivetrainState& state, const FDrivetrainParams& params, float dt, const TorqueType* engineTorque)
+    {
+        const float gearRatio = updateGear(state, params, dt);
+        const float engineRPM = calculateEngineRPM(state.AxleAngVel, gearRatio, params.DiferentialRatio);
+
+        if(engineTorque)
+        {
+            state.EngineRPM = engineTorque->Clamp(engineRPM);
+            state.EngineTorque = engineTorque->Evaluate(state.EngineRPM) * state.Throttle;
+        }
+        else
+        {
+            state.EngineRPM = engineRPM;
+            state.EngineTorque = 0.0f;
+        }
+
+        updateDriveTorque(state, params, gearRatio);
+    }
+}
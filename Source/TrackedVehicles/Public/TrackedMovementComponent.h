@@ -9,6 +9,20 @@
 #include "AI/RVOAvoidanceInterface.h"
 #include "GameFramework/PawnMovementComponent.h"
 #include "GameFramework/Actor.h"
+#include "Core/TrackedContactCache.h"
+#include "Core/TrackedCurveTable.h"
+#include "Core/TrackedFixedStep.h"
+#include "Core/TrackedForceAccumulator.h"
+#include "Core/TrackedFriction.h"
+#include "Core/TrackedGearbox.h"
+#include "Core/TrackedGroundQuery.h"
+#include "Core/TrackedSimulationLod.h"
+#include "Core/TrackedSteering.h"
+#include "Core/TrackedSurfaceTable.h"
+#include "Core/TrackedSuspensionStore.h"
+#include "Core/TrackedVehicleFrame.h"
+#include "Core/TrackedVehicleSimulation.h"
+#include "TrackedReplicatedState.h"
 #include "TrackedMovementComponent.generated.h"
 
 // Should be a UENUM()? or only internal enuum?
@@ -17,7 +31,7 @@ enum ESuspensionSide {
     V_Right
 };
 
-// TODO Make a simple vector and plain CPP structure
+// Blueprint view of a suspension unit, simulation state lives in TrackedCore::FSuspensionStore
 USTRUCT(BlueprintType)
 struct FSuspensionInternalProcessing {
 	GENERATED_USTRUCT_BODY()
@@ -46,6 +60,9 @@ struct FSuspensionInternalProcessing {
 	bool Engaged;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	TEnumAsByte<EPhysicalSurface> HitMaterial;
+	/** Contact of this tick was reprojected from the cached one instead of swept */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	bool ContactReused = false;
 
 
     FSuspensionInternalProcessing() {}
@@ -95,6 +112,51 @@ struct TRACKEDVEHICLES_API FSuspensionSetup {
 	float DampingForce = 4000.0f;
 };
 
+// Ground response of one physical surface, surfaces not listed use the component friction properties
+USTRUCT(BlueprintType)
+struct TRACKEDVEHICLES_API FTrackSurfaceSetup {
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	TEnumAsByte<EPhysicalSurface> Surface;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Mu_X_Static = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Mu_Y_Static = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Mu_X_Kinetic = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Mu_Y_Kinetic = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float RollingFrictionCoef = 0.02f;
+
+	/** How deep the wheels sink into the surface (cm) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float SinkDepth = 0.0f;
+};
+
+// Track inputs of one vehicle, see UTrackedMovementComponent::SetInputsBatch
+USTRUCT(BlueprintType)
+struct TRACKEDVEHICLES_API FTrackedVehicleInput {
+	GENERATED_USTRUCT_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Left = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+	float Right = 0.0f;
+};
+
+class UTrackedVehicleClass;
+
+// ApplyVehicleClass replaced the tuning, track splines and suspension units
+DECLARE_MULTICAST_DELEGATE(FTrackedVehicleClassApplied);
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class TRACKEDVEHICLES_API UTrackedMovementComponent : public UPawnMovementComponent//, public IRVOAvoidanceInterface
 {
@@ -106,6 +168,20 @@ public:
     void SetLeftTorque(float power);
     UFUNCTION(BlueprintCallable, Category = "Inputs")
     void SetRightTorque(float power);
+    /** Set both track inputs, [-1, 1] each: equal drives straight, opposite turns in place, zero brakes */
+    UFUNCTION(BlueprintCallable, Category = "Inputs")
+    void SetTorques(float left, float right);
+    /** Set the track inputs of many vehicles in one call, Inputs[i] goes to Vehicles[i] */
+    UFUNCTION(BlueprintCallable, Category = "Inputs")
+    static void SetInputsBatch(const TArray<UTrackedMovementComponent*>& Vehicles, const TArray<FTrackedVehicleInput>& Inputs);
+    /** C++ side of SetInputsBatch for controllers that keep their own arrays */
+    static void SetInputs(UTrackedMovementComponent* const* vehicles, const FTrackedVehicleInput* inputs, int32 count);
+
+    /** Record the inputs, body state and suspension hits of every ticking vehicle to a replay log, replay it with TrackedVehiclesBenchmark --replay */
+    UFUNCTION(BlueprintCallable, Category = "Replay")
+    static bool StartReplayRecording(const FString& Path);
+    UFUNCTION(BlueprintCallable, Category = "Replay")
+    static void StopReplayRecording();
 
 	UPROPERTY(VisibleAnywhere)
 		UStaticMeshComponent* WheelSweep;
@@ -145,8 +221,20 @@ public:
 		float Mu_Y_Kinetic = 1.0f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 		float RollingFrictionCoef = 0.02f;
+	/** Friction, rolling resistance and sink depth per physical surface */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Surfaces")
+		TArray<FTrackSurfaceSetup> SurfaceSetup;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 		float BrakeForce = 30.0f;
+	/** Track inputs under this magnitude count as released, a released track brakes */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (ClampMin = "0", ClampMax = "1"))
+		float InputDeadZone = 0.05f;
+	/** Brake ratio on the inner track of a turn when it gets no drive, less as its input nears the outer one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (ClampMin = "0", ClampMax = "1"))
+		float InnerTrackBrake = 0.5f;
+	/** Track speed (rad/s) above which an input against the spin brakes the track before reversing it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Inputs", meta = (ClampMin = "0"))
+		float CounterSpinBrakeAngVel = 1.0f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 		float TreadLenght = 972.5f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
@@ -165,6 +253,9 @@ public:
 		TArray<FSuspensionSetup> SuspesionSetupR;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 		TArray<FSuspensionSetup> SuspesionSetupL;
+	/** Stop traces and force evaluation once the vehicle rests without input for SleepTimerSeconds */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		bool AllowSleep = true;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 		float SleepVelocity = 5.0f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
@@ -175,30 +266,194 @@ public:
 		float GearUpShiftPrc = 0.9f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 		float GearDownShiftPrc = 0.05f;
+	/** Seconds the automatic gearbox waits after a shift before it shifts again */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0", EditCondition = "AutoGearBox"))
+		float GearShiftDelay = 0.5f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 		float EngineExtraPowerRatio = 3.0f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 		bool DebugMode = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		TEnumAsByte<ECollisionChannel> SuspensionTraceChannel = ECC_Pawn;
+	/** Submit suspension sweeps asynchronously and consume them on the next tick (one frame latency) */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite)
+		bool AsyncSuspensionTraces = false;
+	/** Answer suspension sweeps that barely moved over static ground from the last traced contact */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Suspension")
+		bool ReuseSuspensionContacts = false;
+	/** Both ends of a sweep must stay this close (cm) to the traced one for its contact to be reused */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Suspension", meta = (EditCondition = "ReuseSuspensionContacts", ClampMin = "0"))
+		float ContactReuseDistance = 2.0f;
+	/** A reused contact is swept again after this many ticks */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Suspension", meta = (EditCondition = "ReuseSuspensionContacts", ClampMin = "1"))
+		int32 ContactReuseMaxTicks = 8;
+	/** Integrate the drivetrain in fixed steps instead of the raw frame time */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Substepping")
+		bool FixedTimestep = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Substepping", meta = (ClampMin = "0.001"))
+		float FixedTimestepSeconds = 1.0f / 120.0f;
+	/** Frame time above MaxSubsteps * FixedTimestepSeconds is dropped */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Substepping", meta = (ClampMin = "1"))
+		int32 MaxSubsteps = 8;
+	/** Simulate through FTrackedVehicleManager, which batches all vehicles of the world across worker threads */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly)
+		bool ManagedTick = false;
+	/** Owning client simulates its inputs ahead and replays the unacknowledged ones on every server snapshot */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Replication")
+		bool PredictOwnerMovement = true;
+	/** Track angular velocity range (rad/s) of the replicated state, faster tracks are clamped */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (ClampMin = "1"))
+		float NetMaxTrackAngVel = 128.0f;
+	/** Bits per replicated suspension length */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Replication", meta = (ClampMin = "1", ClampMax = "8"))
+		int32 NetSuspensionBits = 6;
+	/** Simplify the simulation with the distance to the closest player view */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation LOD")
+		bool DistanceLod = false;
+	/** Beyond this distance only every LodReducedStride-th suspension unit is traced */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation LOD", meta = (EditCondition = "DistanceLod"))
+		float LodReducedDistance = 5000.0f;
+	/** Beyond this distance physics is off and the hull follows the ground under the corner units */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation LOD", meta = (EditCondition = "DistanceLod"))
+		float LodKinematicDistance = 15000.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation LOD", meta = (EditCondition = "DistanceLod"))
+		float LodHysteresis = 500.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation LOD", meta = (EditCondition = "DistanceLod", ClampMin = "1"))
+		int32 LodReducedStride = 2;
+	/** Suspension length the kinematic hull rides at, as a fraction of MaximumLenght */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Simulation LOD", meta = (EditCondition = "DistanceLod", ClampMin = "0", ClampMax = "1"))
+		float KinematicRideRatio = 0.5f;
+
+    /** Shared tuning of the vehicle model. When set, BeginPlay takes the drivetrain, surface and suspension setup from it instead of the properties of this component */
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Vehicle Class")
+        UTrackedVehicleClass* VehicleClass = nullptr;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite)
         UCurveFloat* EngineTorqueCurve;
+    /** Sample EngineTorqueCurve into a lookup table at BeginPlay instead of evaluating the curve every tick */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+        bool BakeEngineTorqueCurve = true;
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "2", EditCondition = "BakeEngineTorqueCurve"))
+        int32 EngineTorqueTableSamples = 256;
+
+    /** Rebuild the engine torque table, call it after changing EngineTorqueCurve at runtime. The component then uses its own table over the vehicle class one */
+    UFUNCTION(BlueprintCallable, Category = "Engine")
+    void BakeEngineTorqueTable();
+
+    /** Rebuild the gearbox shift table, call it after changing GearRatios or the engine curve at runtime. The component then uses its own gearbox over the vehicle class one */
+    UFUNCTION(BlueprintCallable, Category = "Engine")
+    void BuildGearbox();
+
+    /** Select a gear by index into GearRatios, the automatic gearbox overrides it on its next shift */
+    UFUNCTION(BlueprintCallable, Category = "Engine")
+    void SetCurrentGear(int32 gear);
+    UFUNCTION(BlueprintPure, Category = "Engine")
+    int32 GetCurrentGear() const { return CurrentGear; }
+
+    /** Rebuild the surface table, call it after changing SurfaceSetup or the friction properties at runtime. The component then uses its own table over the vehicle class one */
+    UFUNCTION(BlueprintCallable, Category = "Surfaces")
+    void BuildSurfaceTable();
+
+    /** Snapshot of the left track suspension units */
+    UFUNCTION(BlueprintPure, Category = "Suspension")
+    TArray<FSuspensionInternalProcessing> GetLeftSuspensions() const;
+    /** Snapshot of the right track suspension units */
+    UFUNCTION(BlueprintPure, Category = "Suspension")
+    TArray<FSuspensionInternalProcessing> GetRightSuspensions() const;
+
+    /** True while the vehicle rests and skips its simulation */
+    UFUNCTION(BlueprintPure, Category = "Simulation")
+    bool IsAsleep() const { return Sleep.bAsleep; }
+
+    TrackedCore::ESimulationLod GetSimulationLod() const { return SimulationLod; }
+    const TrackedCore::FSuspensionStore& GetSuspensionStore() const { return Suspensions; }
+
+    /** Broadcast at the end of ApplyVehicleClass, anything built from the splines or suspension units rebuilds on it */
+    FTrackedVehicleClassApplied OnVehicleClassApplied;
+
+    /** Bring the vehicle to rest in its start gear, inputs cleared. Tuning, tables and suspension units are kept */
+    UFUNCTION(BlueprintCallable, Category = "Simulation")
+    void ResetSimulationState();
+
+    /** Forget input sequences and snapshot history, for a new owner or a recycled vehicle */
+    void ResetNetState();
+
+    /** Route suspension sweeps to a custom backend, nullptr restores the physics scene */
+    void SetGroundQuery(TrackedCore::IGroundQuery* groundQuery);
+
+	virtual void OnRegister() override;
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void Activate(bool bReset = false) override;
+	virtual void Deactivate() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
+    // Tick phases. Game thread only: BeginSimulationTick, ExecuteSuspensionTraces, ApplyAccumulatedForces, FollowGroundKinematic.
+    // The rest touches only this component's state and may run on worker threads.
+    virtual void BeginSimulationTick(float DeltaTime);
+    virtual void SimulateDrivetrain(float DeltaTime);
+
+    virtual void UpdateSimulationLod();
+    virtual void SetSimulationLod(TrackedCore::ESimulationLod lod);
+    virtual float GetClosestViewerDistance() const;
+    virtual void UpdateSleep(float DeltaTime);
+    virtual void PutToSleep();
+
+    virtual void CaptureVehicleFrame();
     virtual void UpdateThrottle();
     virtual void UpdateWheelsVelocity();
+    virtual void UpdateTreadOffsets();
+    virtual void UpdateTreadUVOffsets();
     virtual void UpdateAxleVelocity();
     virtual void UpdateEngineAndUpdateDrive();
 
     virtual void CalculateCollisions();
-    virtual void CalculateCollisionForProcessor(TArray<FSuspensionInternalProcessing>& processors, int index, ESuspensionSide side);
+    virtual void GatherSuspensionTraces();
+    virtual void ExecuteSuspensionTraces();
+    bool IsContactReuseActive() const;
+    virtual void ExecuteAsyncSuspensionTraces();
+    virtual void ConsumeSuspensionTraces();
+    virtual void EvaluateSuspensionForces();
+    virtual void ApplyAccumulatedForces();
+    virtual void FollowGroundKinematic();
     virtual bool TraceForSuspension(const FVector& start, const FVector& end, float radius, FHitResult& outResult);
 
     virtual void ApplyDriveForcesAndGetFrictionForcesOnSides();
 
     virtual void PrepareInputAxis();
 
+    // Replication. Game thread only: the server captures its state after the tick,
+    // the owning client sends its input at the start of it.
+    virtual void SendNetInput(float DeltaTime);
+    virtual void CaptureNetState();
+    virtual void ApplyNetState();
+    virtual void ReplayNetInputs();
+    void RecordNetInputSteps(int steps);
+
+    UFUNCTION()
+    void OnRep_ReplicatedState();
+
+    UFUNCTION(Server, Unreliable, WithValidation)
+    void ServerSetInput(const FTrackedNetInput& Input);
+
+    // Replay log. Game thread only, after the tick. Writes the vehicle setup on the first
+    // recorded tick, a log replays one recorded tick as one core tick of DT.
+    virtual void RecordReplayTick();
+
+    /** Tread travel interpolated between the last two fixed steps, use it for animation */
+    UFUNCTION(BlueprintPure, Category = "Tracks")
+    float GetVisualTreadOffsetLeft() const { return VisualTreadOffsetLeft; }
+    UFUNCTION(BlueprintPure, Category = "Tracks")
+    float GetVisualTreadOffsetRight() const { return VisualTreadOffsetRight; }
+    /** Texture scroll of the treads in [0, 1), TreadUVTiles repeats along TreadLenght */
+    UFUNCTION(BlueprintPure, Category = "Tracks")
+    float GetTreadUVOffsetLeft() const { return TreadUVOffsetLeft; }
+    UFUNCTION(BlueprintPure, Category = "Tracks")
+    float GetTreadUVOffsetRight() const { return TreadUVOffsetRight; }
+
 protected:
     float DT;
     float RawLeftTorque;
@@ -237,23 +492,90 @@ protected:
 	UPROPERTY(Transient) float EngineTorque;
 	UPROPERTY(Transient) float TrackRollingFrictionTorqueRight;
 	UPROPERTY(Transient) float TrackRollingFrictionTorqueLeft;
-	//UPROPERTY(Transient) UMaterialInstanceDynamic* TreadMaterialLeft;
-	//UPROPERTY(Transient) UMaterialInstanceDynamic* TreadMaterialRight;
 	UPROPERTY(Transient) float TreadUVOffsetRight;
 	UPROPERTY(Transient) float TreadUVOffsetLeft;
 	UPROPERTY(Transient) float TreadMeshOffsetRight;
 	UPROPERTY(Transient) float TreadMeshOffsetLeft;
+	UPROPERTY(Transient) float TreadStepDeltaRight;
+	UPROPERTY(Transient) float TreadStepDeltaLeft;
+	UPROPERTY(Transient) float VisualTreadOffsetRight;
+	UPROPERTY(Transient) float VisualTreadOffsetLeft;
 	UPROPERTY(Transient) float TreadsLastIndex;
 	UPROPERTY(Transient) float SplineLengthAtConstruction;
-	UPROPERTY(Transient) bool SleepMod;
-	UPROPERTY(Transient) float SleepDelayTimer;
 	UPROPERTY(Transient) float LastAutoGearBoxAxleCheck;
 	UPROPERTY(Transient) int NeutralGearIndex;
 
-	UPROPERTY(Transient)
-        TArray<struct FSuspensionInternalProcessing> SuspensionsInternalRight;
-	UPROPERTY(Transient)
-        TArray<struct FSuspensionInternalProcessing> SuspensionsInternalLeft;
+	// Quantized state, server to clients
+	UPROPERTY(Transient, ReplicatedUsing = OnRep_ReplicatedState)
+	FTrackedReplicatedState ReplicatedState;
+
+	// Server: last client input applied. Owning client: last input sent
+	uint16 NetInputSequence = 0;
+	// Server: take the next input whatever its sequence, the owner counts on from its own
+	bool bAcceptNextNetInput = true;
+	// Owning client: inputs the server has not simulated yet
+	TrackedCore::FNetInputHistory NetPendingInputs;
+	// Owning client: input of this frame waits for the steps the drivetrain runs with it
+	bool bNetInputPending = false;
+
+	// Replay recording this vehicle wrote its setup to, and its id in that log
+	uint32 ReplayRecordingSession = 0;
+	uint32 ReplayVehicleId = 0;
+
+	// Rest time before the vehicle skips its simulation
+	TrackedCore::FSleepTimer Sleep;
+
+	// Simulation detail picked from the viewer distance and the units it traces
+	TrackedCore::ESimulationLod SimulationLod = TrackedCore::ESimulationLod::Full;
+	TrackedCore::FTracedUnits TracedSuspensionUnits;
+
+	// Splits frame time into FixedTimestepSeconds steps
+	TrackedCore::FFixedStepAccumulator StepAccumulator;
+
+	// Ground response by EPhysicalSurface, built at BeginPlay
+	TrackedCore::FSurfaceTable SurfaceTable;
+
+	// EngineTorqueCurve baked at BeginPlay (cm units), empty when not baked
+	TrackedCore::FCurveTable EngineTorqueTable;
+
+	// GearRatios with axle speed shift points, built at BeginPlay
+	TrackedCore::FGearbox Gearbox;
+
+	// Tables the tick reads: the ones above, or the shared ones of VehicleClass
+	const TrackedCore::FSurfaceTable* ActiveSurfaceTable = &SurfaceTable;
+	const TrackedCore::FCurveTable* ActiveEngineTorqueTable = &EngineTorqueTable;
+	const TrackedCore::FGearbox* ActiveGearbox = &Gearbox;
+
+	// Transform and body state of the current tick
+	TrackedCore::FVehicleFrame Frame;
+	// World gravity (cm/s^2), read with the frame since worker phases must not ask the world
+	float GravityCm = TrackedCore::StandardGravityCm;
+
+	// Suspension, drive and friction forces of the tick, applied in one call
+	TrackedCore::FForceAccumulator BodyForces;
+
+	// Reactions on other simulated bodies, one accumulator per hit component
+	struct FReactionForces
+	{
+		TWeakObjectPtr<UPrimitiveComponent> Component;
+		TrackedCore::FForceAccumulator Forces;
+	};
+	TArray<FReactionForces> ReactionForces;
+
+	// Engaged contacts of both tracks, rebuilt by the friction solve every tick
+	TrackedCore::FFrictionContactBatch FrictionContacts;
+
+	// Suspension units of both sides (structure of arrays)
+	TrackedCore::FSuspensionStore Suspensions;
+	// Component hit by each suspension unit this tick (receives the reaction force)
+	TArray<TWeakObjectPtr<UPrimitiveComponent>> SuspensionHitComponents;
+	// Sweeps of the traced suspension units, gathered and executed as one batch per tick
+	TrackedCore::FSweepBatch SuspensionTraces;
+	// Last traced contact of every unit, answers sweeps that barely moved
+	TrackedCore::FContactCache ContactCache;
+	TArray<FTraceHandle> SuspensionTraceHandles;
+	FCollisionQueryParams SuspensionQueryParams;
+	TrackedCore::IGroundQuery* GroundQuery = nullptr;
 	UPROPERTY(Transient)
         TArray<UStaticMeshComponent*> SuspHandleRight;
 	UPROPERTY(Transient)
@@ -262,12 +584,18 @@ protected:
 
 
 	virtual void ConstructSuspension();
+	// Take tuning, tables and suspension units from VehicleClass
+	virtual void ApplyVehicleClass();
+	// Size the per unit state after the suspension store changed
+	void ResizeSuspensionState();
+	// Start gear of the active gearbox
+	void ResetGearbox();
+	// Drivetrain phases of one simulation step of DT seconds
+	virtual void SimulateDrivetrainStep();
+	// Tuning and tables in the shape the core drivetrain phases take
+	void MakeDrivetrainParams(TrackedCore::FDrivetrainParams& outParams) const;
+	// Drivetrain members to and from the core state, around every core phase
+	void ReadDrivetrainState(TrackedCore::FDrivetrainState& outState) const;
+	void WriteDrivetrainState(const TrackedCore::FDrivetrainState& state);
 };
 
-
-FORCEINLINE float PrecalculateMomentOfInertia(float sprocketMassKg, float sprocketRadiusCm, float trackMassKg) {
-	float squareRadius = sprocketRadiusCm * sprocketRadiusCm;
-	float trackMassOnSquareRadius = trackMassKg * squareRadius;
-
-	return ((sprocketMassKg * 0.5f) * squareRadius) + trackMassOnSquareRadius;
-};
\ No newline at end of file
@@ -0,0 +1,66 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/NetSerialization.h"
+#include "Core/TrackedNetState.h"
+#include "TrackedReplicatedState.generated.h"
+
+// Track inputs of one client frame, 32 bits on the wire
+USTRUCT()
+struct TRACKEDVEHICLES_API FTrackedNetInput {
+	GENERATED_USTRUCT_BODY()
+
+	uint16 Sequence = 0;
+	float Left = 0.0f;
+	float Right = 0.0f;
+
+	bool NetSerialize(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+};
+
+template<>
+struct TStructOpsTypeTraits<FTrackedNetInput> : public TStructOpsTypeTraitsBase2<FTrackedNetInput>
+{
+	enum
+	{
+		WithNetSerializer = true,
+	};
+};
+
+/// @brief Quantized movement state of a vehicle, replicated as deltas against the state each connection acknowledged
+/// @details The server fills Latest every tick, clients read it in the replication notify.
+/// Nothing is sent while the state matches the acknowledged one.
+USTRUCT()
+struct TRACKEDVEHICLES_API FTrackedReplicatedState {
+	GENERATED_USTRUCT_BODY()
+
+	// Server: snapshot to send. Client: last snapshot received
+	TrackedCore::FVehicleNetSnapshot Latest;
+
+	// Both sides must use the same values
+	TrackedCore::FNetQuantization Quantization;
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms);
+
+	/// @brief Forget the received snapshots and the acknowledged input, for a vehicle starting over
+	/// @details The sequence keeps counting, baselines the connections hold stay valid.
+	void Reset();
+
+private:
+	// Client: baselines the server may write against
+	TrackedCore::FNetSnapshotHistory Received;
+	TrackedCore::FVehicleNetSnapshot Decoded;
+
+	TrackedCore::FNetBitWriter Writer;
+	TArray<uint8> ReadBuffer;
+};
+
+template<>
+struct TStructOpsTypeTraits<FTrackedReplicatedState> : public TStructOpsTypeTraitsBase2<FTrackedReplicatedState>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Core/TrackedCurveTable.h"
+#include "Core/TrackedGearbox.h"
+#include "Core/TrackedSurfaceTable.h"
+#include "Core/TrackedSuspensionStore.h"
+#include "TrackedMovementComponent.h"
+#include "TrackedVehicleClass.generated.h"
+
+class UCurveFloat;
+
+/// @brief Tuning of one vehicle model, shared by every UTrackedMovementComponent that references it
+/// @details Derived constants (track inertia, baked torque table, gear shift thresholds,
+/// surface table, suspension units with their local axes) are built once when the asset
+/// loads. Components point at the tables instead of building their own copies, so spawning
+/// a vehicle of a known model costs no curve sampling or shift table search.
+/// Treat the asset as read only while vehicles use it, call BuildDerivedData after edits at runtime.
+UCLASS(BlueprintType)
+class TRACKEDVEHICLES_API UTrackedVehicleClass : public UDataAsset
+{
+	GENERATED_UCLASS_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		float TrackMassKg = 600.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		float SprocketMassKg = 65.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		float SprocketRadiusCm = 24.05f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		float TreadLenght = 972.5f;
+	/** Track loop of each side in actor space, UTracksBuilderComponent places the links along it */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		TArray<FVector> SplineCoordinatesL;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		TArray<FVector> SplineCoordinatesR;
+	/** Shared by both sides, one per spline point */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		TArray<FVector> SplineTangents;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		float TreadUVTiles = 1.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		float TreadsOnSide = 0.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tracks")
+		float TreadHalfThickness = 0.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drivetrain")
+		TArray<float> GearRatios;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drivetrain")
+		float DiferentialRatio = 3.5f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drivetrain")
+		float TransmissionEfficiency = 0.9f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drivetrain")
+		float BrakeForce = 30.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drivetrain")
+		float EngineExtraPowerRatio = 3.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drivetrain")
+		bool AutoGearBox = true;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drivetrain")
+		float GearUpShiftPrc = 0.9f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drivetrain")
+		float GearDownShiftPrc = 0.05f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Drivetrain", meta = (ClampMin = "0", EditCondition = "AutoGearBox"))
+		float GearShiftDelay = 0.5f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Engine")
+		UCurveFloat* EngineTorqueCurve = nullptr;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Engine", meta = (ClampMin = "2"))
+		int32 EngineTorqueTableSamples = 256;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inputs", meta = (ClampMin = "0", ClampMax = "1"))
+		float InputDeadZone = 0.05f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inputs", meta = (ClampMin = "0", ClampMax = "1"))
+		float InnerTrackBrake = 0.5f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Inputs", meta = (ClampMin = "0"))
+		float CounterSpinBrakeAngVel = 1.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surfaces")
+		float Mu_X_Static = 1.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surfaces")
+		float Mu_Y_Static = 1.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surfaces")
+		float Mu_X_Kinetic = 1.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surfaces")
+		float Mu_Y_Kinetic = 1.0f;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surfaces")
+		float RollingFrictionCoef = 0.02f;
+	/** Friction, rolling resistance and sink depth per physical surface */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surfaces")
+		TArray<FTrackSurfaceSetup> SurfaceSetup;
+
+	/** Units in actor space, RootLoc and RootRot place each unit */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Suspension")
+		TArray<FSuspensionSetup> SuspesionSetupL;
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Suspension")
+		TArray<FSuspensionSetup> SuspesionSetupR;
+
+	/** Rebuild the derived constants from the properties */
+	UFUNCTION(BlueprintCallable, Category = "Vehicle Class")
+	void BuildDerivedData();
+
+	bool HasDerivedData() const { return bDerivedDataBuilt; }
+
+	float GetMomentInertia() const { return MomentInertia; }
+	const TrackedCore::FCurveTable& GetEngineTorqueTable() const { return EngineTorqueTable; }
+	const TrackedCore::FGearbox& GetGearbox() const { return Gearbox; }
+	const TrackedCore::FSurfaceTable& GetSurfaceTable() const { return SurfaceTable; }
+	/** Both sides, left units first. Per tick arrays are sized, a component copies it as its initial state */
+	const TrackedCore::FSuspensionStore& GetSuspensionTemplate() const { return SuspensionTemplate; }
+
+	virtual void PostLoad() override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	bool bDerivedDataBuilt = false;
+	float MomentInertia = 0.0f;
+	// EngineTorqueCurve in cm units, empty without a curve
+	TrackedCore::FCurveTable EngineTorqueTable;
+	TrackedCore::FGearbox Gearbox;
+	TrackedCore::FSurfaceTable SurfaceTable;
+	TrackedCore::FSuspensionStore SuspensionTemplate;
+};
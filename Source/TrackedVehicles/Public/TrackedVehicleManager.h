@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+
+class UTrackedMovementComponent;
+class UWorld;
+
+/// @brief Simulates every managed tracked vehicle of a world in one tick
+/// @details Pure math phases (drivetrain, suspension gather, force evaluation and track friction)
+/// run in ParallelFor batches, physics scene reads and writes stay serialized on
+/// the game thread. Vehicles opt in with UTrackedMovementComponent::ManagedTick.
+class TRACKEDVEHICLES_API FTrackedVehicleManager : public FTickableGameObject
+{
+public:
+	/// @brief Manager of the world, created on first use
+	static FTrackedVehicleManager& Get(UWorld* World);
+
+	/// @brief Remove a vehicle, the manager is destroyed with its last vehicle
+	/// @details Safe from callbacks of the tick, the vehicle is skipped from then on
+	static void Unregister(UWorld* World, UTrackedMovementComponent* Vehicle);
+
+	/// @brief Drop the manager of a world that is cleaned up
+	static void Remove(UWorld* World);
+
+	void Register(UTrackedMovementComponent* Vehicle);
+
+	int32 Num() const { return Vehicles.Num(); }
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+
+private:
+	explicit FTrackedVehicleManager(UWorld* InWorld);
+
+	UWorld* World;
+	TArray<UTrackedMovementComponent*> Vehicles;
+	// Registered while ticking, added after the tick
+	TArray<UTrackedMovementComponent*> PendingVehicles;
+	bool bTicking = false;
+};
@@ -6,6 +6,7 @@
 #include "GameFramework/Pawn.h"
 #include "TrackedMovementComponent.h"
 #include "TracksBuilderComponent.h"
+#include "Templates/SubclassOf.h"
 #include "TrackedVehiclePawn.generated.h"
 
 UCLASS()
@@ -38,4 +39,33 @@ public:
 	/// @brief Reference to the tracks builder
 	UPROPERTY(Category = "TrackedVehicle", BlueprintReadWrite, EditAnywhere)
 	UTracksBuilderComponent* TracksBuilder;
+
+	/// @brief Take a vehicle of PawnClass from the pool of the world
+	/// @details Spawns a new one when the pool has none free. See FTrackedVehiclePool
+	UFUNCTION(BlueprintCallable, Category = "TrackedVehicle|Pool", meta = (WorldContext = "WorldContextObject"))
+	static ATrackedVehiclePawn* SpawnPooled(UObject* WorldContextObject, TSubclassOf<ATrackedVehiclePawn> PawnClass, const FTransform& Transform);
+
+	/// @brief Spawn vehicles ahead of a wave so it only recycles them
+	UFUNCTION(BlueprintCallable, Category = "TrackedVehicle|Pool", meta = (WorldContext = "WorldContextObject"))
+	static void PrewarmPool(UObject* WorldContextObject, TSubclassOf<ATrackedVehiclePawn> PawnClass, int32 Count);
+
+	/// @brief Park the vehicle in the pool instead of destroying it
+	UFUNCTION(BlueprintCallable, Category = "TrackedVehicle|Pool")
+	void ReturnToPool();
+
+	UFUNCTION(BlueprintPure, Category = "TrackedVehicle|Pool")
+	bool IsPooled() const { return bPooled; }
+
+	/// @brief Called by the pool: hide the vehicle, stop its simulation and release its controller
+	virtual void EnterPool();
+
+	/// @brief Called by the pool: place the vehicle at Transform and resume from rest
+	virtual void LeavePool(const FTransform& Transform);
+
+	virtual void PossessedBy(AController* NewController) override;
+
+protected:
+	bool bPooled = false;
+	// Body simulated physics when the vehicle was parked
+	bool bPooledBodySimulated = false;
 };
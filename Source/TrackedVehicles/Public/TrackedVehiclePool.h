@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/SubclassOf.h"
+
+class ATrackedVehiclePawn;
+class UWorld;
+
+/// @brief Keeps despawned tracked vehicles of a world for reuse
+/// @details A released vehicle is hidden and stops simulating but keeps its components,
+/// tables and suspension arrays. Acquiring it again only moves it and resets its
+/// simulation state, so a wave of vehicles costs no actor spawn or component setup
+/// once the pool holds enough of them. Spawn on the server or in standalone games,
+/// clients receive the vehicles through replication.
+class TRACKEDVEHICLES_API FTrackedVehiclePool
+{
+public:
+	/// @brief Pool of the world, created on first use
+	static FTrackedVehiclePool& Get(UWorld* World);
+
+	/// @brief Forget the pool of a world, its vehicles are destroyed with the world
+	static void Remove(UWorld* World);
+
+	/// @brief Free vehicle of exactly PawnClass placed at Transform, a new one when none is free
+	ATrackedVehiclePawn* Acquire(TSubclassOf<ATrackedVehiclePawn> PawnClass, const FTransform& Transform);
+
+	/// @brief Park a vehicle until the next Acquire of its class
+	void Release(ATrackedVehiclePawn* Vehicle);
+
+	/// @brief Spawn vehicles straight into the pool until Count of PawnClass are free
+	void Prewarm(TSubclassOf<ATrackedVehiclePawn> PawnClass, int32 Count);
+
+	int32 NumFree(TSubclassOf<ATrackedVehiclePawn> PawnClass) const;
+
+private:
+	explicit FTrackedVehiclePool(UWorld* InWorld);
+
+	ATrackedVehiclePawn* Spawn(TSubclassOf<ATrackedVehiclePawn> PawnClass, const FTransform& Transform);
+
+	UWorld* World;
+	// Parked vehicles by class, the last released is reused first
+	TMap<UClass*, TArray<TWeakObjectPtr<ATrackedVehiclePawn>>> FreeVehicles;
+};
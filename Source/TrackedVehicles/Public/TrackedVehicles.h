@@ -4,6 +4,40 @@
 
 #include "CoreMinimal.h"
 #include "ModuleManager.h"
+#include "Core/TrackedProfiler.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogTrackedVehicles, Log, All);
+
+// "stat TrackedVehicles": tick phases summed over every vehicle, counters per frame
+DECLARE_STATS_GROUP(TEXT("TrackedVehicles"), STATGROUP_TrackedVehicles, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Begin Tick"), STAT_TrackedBeginTick, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Drivetrain"), STAT_TrackedDrivetrain, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Gather Traces"), STAT_TrackedGatherTraces, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Execute Traces"), STAT_TrackedExecuteTraces, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Consume Traces"), STAT_TrackedConsumeTraces, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Suspension Forces"), STAT_TrackedSuspensionForces, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Friction"), STAT_TrackedFriction, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Apply Forces"), STAT_TrackedApplyForces, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Ground Follow"), STAT_TrackedGroundFollow, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Traces Issued"), STAT_TrackedTraces, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Engaged Contacts"), STAT_TrackedEngagedContacts, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Forces Applied"), STAT_TrackedForcesApplied, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Sleeping Vehicles"), STAT_TrackedSleepingVehicles, STATGROUP_TrackedVehicles, TRACKEDVEHICLES_API);
+
+// Engine cycle stat plus the TrackedCore profiler scope (Chrome trace in the headless build) of a tick phase
+#define TRACKED_PHASE_SCOPE(Stat, Scope) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	TRACKEDCORE_PROFILE_SCOPE(Scope)
+
+// Engine counter stat plus the matching TrackedCore profiler counter
+#define TRACKED_COUNTER(Stat, Counter, Value) \
+	do { \
+		const int64 trackedCounterValue = (Value); \
+		INC_DWORD_STAT_BY(Stat, trackedCounterValue); \
+		TrackedCore::profileCounter(TrackedCore::EProfileCounter::Counter, trackedCounterValue); \
+	} while(0)
 
 class FTrackedVehiclesModule : public IModuleInterface
 {
@@ -12,4 +46,7 @@ public:
 	/** IModuleInterface implementation */
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	FDelegateHandle WorldCleanupHandle;
 };
\ No newline at end of file
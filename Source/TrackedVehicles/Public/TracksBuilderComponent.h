@@ -4,11 +4,118 @@
 
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
+#include "Core/TrackedTrackPath.h"
+#include <vector>
 #include "TracksBuilderComponent.generated.h"
 
+class UInstancedStaticMeshComponent;
+class UMaterialParameterCollection;
+class UMaterialParameterCollectionInstance;
+class UPrimitiveComponent;
+class UStaticMesh;
+class UTrackedMovementComponent;
 
+UENUM(BlueprintType)
+enum class ETrackRenderMode : uint8
+{
+	/** Instanced link meshes placed along the track spline */
+	Links,
+	/** Tread meshes with a scrolling material, the cheapest mode for distant vehicles */
+	ScrollingMaterial
+};
+
+/// @brief Renders the track links of a UTrackedMovementComponent as instanced meshes
+/// @details Each side is one instanced mesh component with TreadsOnSide links placed along
+/// the track spline. The spline is resampled by arc length once when the tracks are built,
+/// after that a tick only places links at the tread offset and pushes them in one render update.
+/// With FollowSuspension the spline points under the wheels move with the suspension, and only
+/// the segments next to a wheel that moved are resampled and only their links updated.
+/// In ScrollingMaterial mode no links are created, the tread UV offsets of the movement component
+/// are pushed to the tread material instead: two custom primitive data floats on the tread
+/// component where the engine has them, one parameter collection write otherwise.
 UCLASS(ClassGroup=(TrackedVehicles), meta=(BlueprintSpawnableComponent) )
 class TRACKEDVEHICLES_API UTracksBuilderComponent : public UActorComponent
 {
-	GENERATED_BODY()
+	GENERATED_UCLASS_BODY()
+
+public:
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks")
+		ETrackRenderMode RenderMode = ETrackRenderMode::Links;
+	/** Mesh of a single link, pivot at the link center, X along the track and Z away from the wheels */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks")
+		UStaticMesh* LinkMesh;
+	/** Instanced component class of each side, hierarchical instances add per cluster culling and LOD */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks")
+		TSubclassOf<UInstancedStaticMeshComponent> LinkComponentClass;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks")
+		FVector LinkScale = FVector(1.0f, 1.0f, 1.0f);
+	/** Arc length samples per spline segment of the track path */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks", meta = (ClampMin = "1"))
+		int32 PathSamplesPerSegment = 16;
+	/** Bend the track around the wheels as the suspension moves */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks")
+		bool FollowSuspension = true;
+	/** Suspension length, as a fraction of its maximum, the track splines were authored at */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks", meta = (ClampMin = "0", ClampMax = "1"))
+		float SplineSuspensionRatio = 1.0f;
+	/** Suspension travel (cm) below which a wheel keeps its part of the track as it is */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks", meta = (ClampMin = "0"))
+		float FollowSuspensionEpsilon = 0.25f;
+
+	/** Component rendering the treads in ScrollingMaterial mode, None uses the vehicle body */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks|Material")
+		FName TreadComponentName;
+	/** Custom primitive data index of the left tread UV offset, the right one follows it */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks|Material", meta = (ClampMin = "0"))
+		int32 TreadUVDataIndex = 0;
+	/** Collection receiving the offsets on engines without custom primitive data */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks|Material")
+		UMaterialParameterCollection* TreadParameterCollection;
+	/** Vector parameter of TreadParameterCollection, R is the left tread offset and G the right one */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Tracks|Material")
+		FName TreadUVOffsetParameter = TEXT("TreadUVOffset");
+
+	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	/** Resample the track splines of the movement component and recreate the link instances */
+	UFUNCTION(BlueprintCallable, Category = "Tracks")
+	void BuildTracks();
+
+	UFUNCTION(BlueprintPure, Category = "Tracks")
+	float GetTrackLengthLeft() const { return PathLeft.GetLength(); }
+	UFUNCTION(BlueprintPure, Category = "Tracks")
+	float GetTrackLengthRight() const { return PathRight.GetLength(); }
+
+protected:
+	UPROPERTY(Transient) UTrackedMovementComponent* Movement;
+	UPROPERTY(Transient) UInstancedStaticMeshComponent* LinksLeft;
+	UPROPERTY(Transient) UInstancedStaticMeshComponent* LinksRight;
+	UPROPERTY(Transient) float LinkPhaseLeft;
+	UPROPERTY(Transient) float LinkPhaseRight;
+	UPROPERTY(Transient) UPrimitiveComponent* TreadComponent;
+	UPROPERTY(Transient) UMaterialParameterCollectionInstance* TreadParameters;
+	UPROPERTY(Transient) float TreadUVOffsetLeft;
+	UPROPERTY(Transient) float TreadUVOffsetRight;
+
+	int NumLinksOnSide = 0;
+
+	// Arc length resampled track splines, built once by BuildTracks
+	TrackedCore::FTrackPath PathLeft;
+	TrackedCore::FTrackPath PathRight;
+
+	// Spline points riding on the wheels, moved with the suspension
+	TrackedCore::FTrackPathBinding BindingLeft;
+	TrackedCore::FTrackPathBinding BindingRight;
+
+	// Link placement of one side, reused every tick
+	std::vector<TrackedCore::FTrackLinkTransform> LinkTransforms;
+
+	UInstancedStaticMeshComponent* CreateLinks(FName name);
+	void DestroyLinks();
+	void BuildPath(const TArray<FVector>& coordinates, TrackedCore::FTrackPath& outPath) const;
+	void BuildTreadMaterial();
+	void UpdateTreadMaterial();
+	void UpdateLinks(UInstancedStaticMeshComponent* links, TrackedCore::FTrackPath& path, TrackedCore::FTrackPathBinding& binding, float treadOffset, float& inOutPhase);
 };
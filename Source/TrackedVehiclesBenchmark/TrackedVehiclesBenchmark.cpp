@@ -0,0 +1,618 @@
+// Headless drivetrain benchmark, built by the root CMakeLists.txt (not part of the Unreal module).
+//
+// Runs N vehicles x M wheels for K ticks through the TrackedCore pipeline
+// (throttle, wheels velocity, axle, engine, suspension sweeps and forces)
+// against a synthetic ground (plane, analytic waves or the waves baked into
+// a heightfield) and reports time per vehicle tick, throughput
+// and heap allocations made during the measured ticks. --trace writes the
+// phase scopes of the measured ticks as a Chrome trace (chrome://tracing).
+// --net replicates every vehicle each tick as a delta snapshot and reports
+// the bytes a client would receive. --record writes every tick to a replay
+// log, --replay runs a log through the core --repeat times and checks the
+// replayed state against the recorded one bit for bit.
+
+#include "Core/TrackedDrivetrain.h"
+#include "Core/TrackedGroundQuery.h"
+#include "Core/TrackedHeightfield.h"
+#include "Core/TrackedNetState.h"
+#include "Core/TrackedProfiler.h"
+#include "Core/TrackedReplayLog.h"
+#include "Core/TrackedVehicleSimulation.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::atomic<long long> GAllocationCount(0);
+    std::atomic<long long> GAllocationBytes(0);
+}
+
+void* operator new(std::size_t size)
+{
+    GAllocationCount++;
+    GAllocationBytes += (long long)size;
+    if(void* memory = std::malloc(size ? size : 1))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace
+{
+    using namespace TrackedCore;
+
+    struct FBenchmarkOptions
+    {
+        int Vehicles = 200;
+        int Wheels = 16;
+        int Ticks = 1000;
+        int WarmupTicks = 50;
+        float DeltaTime = 1.0f / 60.0f;
+        std::string Ground = "flat";
+        std::string Lod = "full";
+        bool ReuseContacts = false;
+        bool Net = false;
+        std::string JsonPath;
+        std::string TracePath;
+        std::string RecordPath;
+        std::string ReplayPath;
+        int Repeat = 1;
+    };
+
+    // Stride of the reduced LOD, recorded with the vehicle setup
+    const int ReducedStride = 2;
+
+    /// @brief Rolling sine hills in 10 m bands of default ground and mud (surface type 1),
+    /// contact is solved against the tangent plane under the wheel
+    class FWaveGroundQuery : public IGroundQuery
+    {
+    public:
+        FWaveGroundQuery(float amplitude, float wavelength)
+            : Amplitude(amplitude)
+            , Frequency(2.0f * Pi / wavelength)
+        {
+        }
+
+        float HeightAt(float x, float y) const
+        {
+            return Amplitude * std::sin(x * Frequency) * std::cos(y * Frequency);
+        }
+
+        static uint8_t SurfaceAt(float x)
+        {
+            return (uint8_t)((int)std::floor(x / 1000.0f) & 1);
+        }
+
+        virtual void SweepBatch(const FSweepRequest* requests, FSweepHit* hits, int count) override
+        {
+            for(int index = 0; index < count; index++)
+            {
+                const FVec3& start = requests[index].Start;
+                float height = HeightAt(start.X, start.Y);
+                float slopeX = Amplitude * Frequency * std::cos(start.X * Frequency) * std::cos(start.Y * Frequency);
+                float slopeY = -Amplitude * Frequency * std::sin(start.X * Frequency) * std::sin(start.Y * Frequency);
+
+                FFlatGroundQuery plane(FVec3(start.X, start.Y, height), FVec3(-slopeX, -slopeY, 1.0f), SurfaceAt(start.X));
+                plane.SweepBatch(requests + index, hits + index, 1);
+            }
+        }
+
+    private:
+        float Amplitude;
+        float Frequency;
+    };
+
+    /// @brief Bake the waves under the whole run into a 1 m heightfield, vehicles only drive along X
+    void buildWaveHeightfield(const FWaveGroundQuery& waves, const FBenchmarkOptions& options, FHeightfield& outHeightfield)
+    {
+        const float cellSize = 100.0f;
+        // Faster than any gear reaches, in cm/s
+        const float travel = 2500.0f * (options.WarmupTicks + options.Ticks) * options.DeltaTime + 1000.0f;
+        const FVec3 origin(-travel, -1000.0f, 0.0f);
+        const int numX = (int)std::ceil(2.0f * travel / cellSize) + 1;
+        const int numY = (int)std::ceil(((options.Vehicles - 1) * 2000.0f + 2000.0f) / cellSize) + 1;
+
+        outHeightfield.Build(origin, cellSize, numX, numY, [&waves](float x, float y) { return waves.HeightAt(x, y); });
+
+        outHeightfield.SurfaceTypes.resize(outHeightfield.Heights.size());
+        for(int y = 0; y < numY; y++)
+        {
+            for(int x = 0; x < numX; x++)
+            {
+                outHeightfield.SurfaceTypes[(size_t)y * numX + x] = FWaveGroundQuery::SurfaceAt(origin.X + x * cellSize);
+            }
+        }
+    }
+
+    float syntheticTorqueCurve(float rpm)
+    {
+        // Nm, peak around 1800 RPM
+        float normalized = (rpm - 1800.0f) / 1400.0f;
+        return 4000.0f * (1.0f - 0.5f * normalized * normalized);
+    }
+
+    ESimulationLod parseLod(const std::string& lod)
+    {
+        return lod == "kinematic" ? ESimulationLod::Kinematic : (lod == "reduced" ? ESimulationLod::Reduced : ESimulationLod::Full);
+    }
+
+    void setupVehicle(FVehicleSimulation& vehicle, int vehicleIndex, int wheels, ESimulationLod lod, bool reuseContacts, const FCurveTable& torqueTable, const FGearbox& gearbox)
+    {
+        vehicle.Params.MomentInertia = precalculateMomentOfInertia(65.0f, 24.05f, 600.0f);
+        vehicle.Params.EngineTorque = &torqueTable;
+        vehicle.Params.Gearbox = &gearbox;
+
+        FSurfaceParams mud;
+        mud.MuXStatic = 0.7f;
+        mud.MuYStatic = 0.6f;
+        mud.MuXKinetic = 0.5f;
+        mud.MuYKinetic = 0.4f;
+        mud.RollingFrictionCoef = 0.08f;
+        mud.SinkDepth = 4.0f;
+        vehicle.Surfaces.Set(1, mud);
+
+        // Column of vehicles 20 m apart, hull 50 cm above ground so the wheels are compressed
+        vehicle.Frame.Location = FVec3(0.0f, vehicleIndex * 2000.0f, 50.0f);
+        vehicle.Frame.UpdateBasis();
+        vehicle.Frame.CenterOfMass = vehicle.Frame.Location;
+        vehicle.Frame.Mass = 30000.0f;
+
+        const int wheelsOnSide = wheels / 2;
+        vehicle.Suspensions.Reserve(wheelsOnSide * 2);
+        vehicle.FrictionContacts.Reserve(wheelsOnSide * 2);
+        for(int side = 0; side < 2; side++)
+        {
+            for(int wheel = 0; wheel < wheelsOnSide; wheel++)
+            {
+                FSuspensionUnitSetup setup;
+                setup.RootLocation = FVec3(-250.0f + 500.0f * wheel / (float)(wheelsOnSide > 1 ? wheelsOnSide - 1 : 1), side == 0 ? -150.0f : 150.0f, 0.0f);
+                setup.Length = 23.0f;
+                setup.Radius = 34.0f;
+                setup.Stiffness = 4000000.0f;
+                setup.Damping = 4000.0f;
+                vehicle.Suspensions.Add(side == 0 ? ETrackSide::Left : ETrackSide::Right, setup);
+            }
+        }
+        setSimulationLod(vehicle, lod, ReducedStride);
+        vehicle.bReuseContacts = reuseContacts;
+
+        // Deterministic mix of inputs: straight, pivot, gentle turns and braking
+        switch(vehicleIndex % 4)
+        {
+        case 0: vehicle.Drivetrain.RawLeftTorque = 1.0f; vehicle.Drivetrain.RawRightTorque = 1.0f; break;
+        case 1: vehicle.Drivetrain.RawLeftTorque = 1.0f; vehicle.Drivetrain.RawRightTorque = -1.0f; break;
+        case 2: vehicle.Drivetrain.RawLeftTorque = 1.0f; vehicle.Drivetrain.RawRightTorque = 0.5f; break;
+        default: break;
+        }
+    }
+
+    void tickVehicle(FVehicleSimulation& vehicle, IGroundQuery& ground, float dt, FReplayLogWriter& recorder, uint32_t vehicleId)
+    {
+        const FDrivetrainState& drivetrain = vehicle.Drivetrain;
+
+        if(!recorder.IsOpen())
+        {
+            simulateVehicleTick(vehicle, ground, dt);
+        }
+        else
+        {
+            FReplayVehicleTick tick;
+            tick.VehicleId = vehicleId;
+            tick.DeltaTime = dt;
+            tick.RawLeftTorque = drivetrain.RawLeftTorque;
+            tick.RawRightTorque = drivetrain.RawRightTorque;
+            tick.Lod = vehicle.Lod;
+            tick.Frame = vehicle.Frame;
+
+            simulateVehicleTick(vehicle, ground, dt);
+
+            tick.Hits = vehicle.Traces.Hits.data();
+            tick.NumHits = vehicle.Traces.Num();
+            tick.bHasState = true;
+            tick.State = captureReplayVehicleState(vehicle);
+            recorder.WriteTick(tick);
+        }
+
+        // Kinematic motion along the hull forward axis so the wheels see new ground
+        float speed = (drivetrain.TrackLeftLinVel + drivetrain.TrackRightLinVel) * 0.5f;
+        vehicle.Frame.LinearVelocity = vehicle.Frame.Forward * speed;
+        vehicle.Frame.Location += vehicle.Frame.LinearVelocity * dt;
+        vehicle.Frame.CenterOfMass = vehicle.Frame.Location;
+    }
+
+    /// @brief Server to client replication of one vehicle, each snapshot acknowledged before the next
+    struct FNetReplica
+    {
+        FVehicleNetSnapshot Baseline;
+        FVehicleNetSnapshot Sent;
+        FVehicleNetSnapshot Received;
+        FNetSnapshotHistory ClientHistory;
+        bool bAcked = false;
+    };
+
+    /// @return bits sent, mismatches counts snapshots the client decoded differently
+    int replicateVehicle(const FVehicleSimulation& vehicle, const FNetQuantization& quantization, FNetReplica& replica, FNetBitWriter& writer, int& mismatches)
+    {
+        const FDrivetrainState& drivetrain = vehicle.Drivetrain;
+
+        FNetVehicleState state;
+        state.TrackLeftAngVel = drivetrain.TrackLeftAngVel;
+        state.TrackRightAngVel = drivetrain.TrackRightAngVel;
+        state.Throttle = drivetrain.Throttle;
+        state.EngineRPM = drivetrain.EngineRPM;
+        state.InputLeft = drivetrain.RawLeftTorque;
+        state.InputRight = drivetrain.RawRightTorque;
+        state.Gear = drivetrain.Gearbox.Gear;
+        state.bReverse = drivetrain.Gearbox.bReverse;
+
+        std::swap(replica.Baseline, replica.Sent);
+        quantizeNetState(state, vehicle.Suspensions, quantization, replica.Sent);
+        replica.Sent.Sequence = (uint16_t)(replica.Baseline.Sequence + 1);
+
+        const bool delta = replica.bAcked && !needsFullNetSnapshot(replica.Sent.Sequence, replica.Baseline.Sequence);
+        writer.Reset();
+        writeNetSnapshot(writer, replica.Sent, delta ? &replica.Baseline : nullptr, quantization);
+
+        FNetBitReader reader(writer.GetBytes().data(), writer.GetNumBits());
+        if(readNetSnapshot(reader, replica.ClientHistory, quantization, replica.Received) == ENetSnapshotRead::Ok && replica.Received.IsStateEqual(replica.Sent))
+        {
+            replica.ClientHistory.Add(replica.Received);
+            replica.bAcked = true;
+        }
+        else
+        {
+            mismatches++;
+        }
+
+        return writer.GetNumBits();
+    }
+
+    /// @brief Vehicle of a replay log, Simulation.Params points into Setup
+    struct FReplayVehicle
+    {
+        FReplayVehicleSetup Setup;
+        FVehicleSimulation Simulation;
+    };
+
+    /// @brief Replay a log once to build the vehicles and warm the buffers, then time --repeat passes
+    int runReplay(const FBenchmarkOptions& options)
+    {
+        FReplayLogFile file;
+        if(!file.Open(options.ReplayPath.c_str()))
+        {
+            std::fprintf(stderr, "cannot read replay log %s\n", options.ReplayPath.c_str());
+            return 1;
+        }
+
+        FReplayLogReader reader(file);
+        FReplayGroundQuery ground;
+        std::vector<std::unique_ptr<FReplayVehicle>> vehicles;
+        uint32_t vehicleId = 0;
+        FReplayVehicleSetup setup;
+        FReplayVehicleTick tick;
+
+        long long vehicleTicks = 0;
+        long long mismatches = 0;
+        long long unknownTicks = 0;
+        long long allocationsBefore = 0;
+        long long bytesBefore = 0;
+        auto startTime = std::chrono::steady_clock::now();
+
+        for(int pass = 0; pass <= options.Repeat; pass++)
+        {
+            if(pass == 1)
+            {
+                vehicleTicks = 0;
+                allocationsBefore = GAllocationCount.load();
+                bytesBefore = GAllocationBytes.load();
+                startTime = std::chrono::steady_clock::now();
+            }
+
+            // Vehicle chunks precede the ticks of their vehicle, every pass starts from the recorded setup
+            reader.Rewind();
+            for(;;)
+            {
+                const FReplayLogReader::EChunk chunk = reader.Next(vehicleId, setup, tick);
+                if(chunk == FReplayLogReader::EChunk::End)
+                {
+                    break;
+                }
+                if(chunk == FReplayLogReader::EChunk::Corrupt)
+                {
+                    std::fprintf(stderr, "corrupt replay log %s\n", options.ReplayPath.c_str());
+                    return 1;
+                }
+
+                if(chunk == FReplayLogReader::EChunk::Vehicle)
+                {
+                    if(vehicleId >= vehicles.size())
+                    {
+                        vehicles.resize(vehicleId + 1);
+                    }
+                    if(!vehicles[vehicleId])
+                    {
+                        vehicles[vehicleId].reset(new FReplayVehicle());
+                    }
+
+                    FReplayVehicle& vehicle = *vehicles[vehicleId];
+                    vehicle.Setup = setup;
+                    applyReplayVehicleSetup(vehicle.Setup, vehicle.Simulation);
+                    continue;
+                }
+
+                if(tick.VehicleId >= vehicles.size() || !vehicles[tick.VehicleId])
+                {
+                    unknownTicks++;
+                    continue;
+                }
+
+                FReplayVehicle& vehicle = *vehicles[tick.VehicleId];
+                if(!replayVehicleTick(vehicle.Simulation, vehicle.Setup.ReducedStride, tick, ground))
+                {
+                    mismatches++;
+                }
+                vehicleTicks++;
+            }
+        }
+
+        const auto endTime = std::chrono::steady_clock::now();
+        const long long allocations = GAllocationCount.load() - allocationsBefore;
+        const long long allocatedBytes = GAllocationBytes.load() - bytesBefore;
+
+        const double totalNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+        std::printf("replay %s, %d vehicles, %lld vehicle-ticks x %d\n", options.ReplayPath.c_str(), (int)vehicles.size(), vehicleTicks / options.Repeat, options.Repeat);
+        std::printf("  %.1f ns/vehicle-tick\n", vehicleTicks > 0 ? totalNs / (double)vehicleTicks : 0.0);
+        std::printf("  %lld allocations (%lld bytes) during timed passes\n", allocations, allocatedBytes);
+        std::printf("  %lld mismatched vehicle-ticks, %d sweeps without a recorded hit, %lld ticks of unknown vehicles\n",
+            mismatches, ground.GetNumMissing(), unknownTicks);
+
+        return mismatches > 0 ? 2 : 0;
+    }
+
+    bool parseOptions(int argc, char** argv, FBenchmarkOptions& options)
+    {
+        for(int index = 1; index < argc; index++)
+        {
+            std::string argument = argv[index];
+            const char* value = index + 1 < argc ? argv[index + 1] : nullptr;
+
+            if(argument == "--vehicles" && value) { options.Vehicles = std::atoi(value); index++; }
+            else if(argument == "--wheels" && value) { options.Wheels = std::atoi(value); index++; }
+            else if(argument == "--ticks" && value) { options.Ticks = std::atoi(value); index++; }
+            else if(argument == "--warmup" && value) { options.WarmupTicks = std::atoi(value); index++; }
+            else if(argument == "--dt" && value) { options.DeltaTime = (float)std::atof(value); index++; }
+            else if(argument == "--ground" && value) { options.Ground = value; index++; }
+            else if(argument == "--lod" && value) { options.Lod = value; index++; }
+            else if(argument == "--reuse-contacts") { options.ReuseContacts = true; }
+            else if(argument == "--net") { options.Net = true; }
+            else if(argument == "--json" && value) { options.JsonPath = value; index++; }
+            else if(argument == "--trace" && value) { options.TracePath = value; index++; }
+            else if(argument == "--record" && value) { options.RecordPath = value; index++; }
+            else if(argument == "--replay" && value) { options.ReplayPath = value; index++; }
+            else if(argument == "--repeat" && value) { options.Repeat = std::atoi(value); index++; }
+            else
+            {
+                std::fprintf(stderr,
+                    "usage: %s [--vehicles N] [--wheels M] [--ticks K] [--warmup W] [--dt S] [--ground flat|waves|heightfield] [--lod full|reduced|kinematic] [--reuse-contacts] [--net] [--json PATH] [--trace PATH] [--record PATH] [--replay PATH] [--repeat N]\n",
+                    argv[0]);
+                return false;
+            }
+        }
+
+        return options.Vehicles > 0 && options.Wheels >= 2 && options.Ticks > 0 && options.Repeat > 0
+            && (options.Ground == "flat" || options.Ground == "waves" || options.Ground == "heightfield")
+            && (options.Lod == "full" || options.Lod == "reduced" || options.Lod == "kinematic");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    FBenchmarkOptions options;
+    if(!parseOptions(argc, argv, options))
+    {
+        return 1;
+    }
+
+    if(!options.ReplayPath.empty())
+    {
+        return runReplay(options);
+    }
+
+    FCurveTable torqueTable;
+    torqueTable.Build(400.0f, 3200.0f, 256, [](float rpm) { return syntheticTorqueCurve(rpm) * M2CM; });
+
+    // Reverse, neutral and five forward gears, shift points placed on the torque curve
+    const float gearRatios[] = { -4.0f, 0.0f, 4.0f, 2.6f, 1.8f, 1.3f, 1.0f };
+    FGearbox gearbox;
+    gearbox.Build(gearRatios, 7, 3.5f, torqueTable.MinTime, torqueTable.MaxTime, FGearboxSettings());
+    gearbox.BuildShiftTable(3.5f, torqueTable.MinTime, torqueTable.MaxTime, [&torqueTable](float rpm) { return torqueTable.Evaluate(rpm); });
+
+    FFlatGroundQuery flatGround(FVec3(), FVec3(0.0f, 0.0f, 1.0f));
+    FWaveGroundQuery waveGround(10.0f, 800.0f);
+    FHeightfield heightfield;
+    if(options.Ground == "heightfield")
+    {
+        buildWaveHeightfield(waveGround, options, heightfield);
+    }
+    FHeightfieldGroundQuery heightfieldGround(heightfield);
+    IGroundQuery& ground = options.Ground == "flat" ? (IGroundQuery&)flatGround
+        : (options.Ground == "waves" ? (IGroundQuery&)waveGround : (IGroundQuery&)heightfieldGround);
+
+    std::vector<FVehicleSimulation> vehicles(options.Vehicles);
+    for(int index = 0; index < options.Vehicles; index++)
+    {
+        setupVehicle(vehicles[index], index, options.Wheels, parseLod(options.Lod), options.ReuseContacts, torqueTable, gearbox);
+    }
+
+    // Every tick from the first warmup tick on, so a replay starts from the same state
+    FReplayLogWriter recorder;
+    if(!options.RecordPath.empty())
+    {
+        if(!recorder.Open(options.RecordPath.c_str()))
+        {
+            std::fprintf(stderr, "cannot write %s\n", options.RecordPath.c_str());
+            return 1;
+        }
+
+        FReplayVehicleSetup setup;
+        for(int index = 0; index < options.Vehicles; index++)
+        {
+            const FVehicleSimulation& vehicle = vehicles[index];
+            captureReplayVehicleSetup(vehicle.Params, &gearbox, &torqueTable, vehicle.Surfaces, vehicle.Friction.SprocketRadiusCm, ReducedStride, vehicle.Suspensions, setup);
+            recorder.WriteVehicle((uint32_t)index, setup);
+        }
+    }
+
+    // Replicas exist only with --net, the measured loop skips them otherwise
+    const FNetQuantization quantization;
+    std::vector<FNetReplica> replicas(options.Net ? options.Vehicles : 0);
+    FNetBitWriter netWriter;
+    long long netBits = 0;
+    int netMismatches = 0;
+
+    for(int tick = 0; tick < options.WarmupTicks; tick++)
+    {
+        for(int index = 0; index < options.Vehicles; index++)
+        {
+            tickVehicle(vehicles[index], ground, options.DeltaTime, recorder, (uint32_t)index);
+            if(options.Net)
+            {
+                replicateVehicle(vehicles[index], quantization, replicas[index], netWriter, netMismatches);
+            }
+        }
+    }
+
+    // Phase scopes of the measured ticks as a Chrome trace, recording allocates and slows every tick
+    FChromeTraceWriter traceWriter;
+    if(!options.TracePath.empty())
+    {
+        setProfilerSink(&traceWriter);
+    }
+
+    long long sweeps = 0;
+    const long long allocationsBefore = GAllocationCount.load();
+    const long long bytesBefore = GAllocationBytes.load();
+    const auto startTime = std::chrono::steady_clock::now();
+
+    for(int tick = 0; tick < options.Ticks; tick++)
+    {
+        for(int index = 0; index < options.Vehicles; index++)
+        {
+            tickVehicle(vehicles[index], ground, options.DeltaTime, recorder, (uint32_t)index);
+            sweeps += vehicles[index].NumSweeps;
+            if(options.Net)
+            {
+                netBits += replicateVehicle(vehicles[index], quantization, replicas[index], netWriter, netMismatches);
+            }
+        }
+    }
+
+    const auto endTime = std::chrono::steady_clock::now();
+    setProfilerSink(nullptr);
+    const long long allocations = GAllocationCount.load() - allocationsBefore;
+    const long long allocatedBytes = GAllocationBytes.load() - bytesBefore;
+
+    // Checksum of the final state, identical across runs of the same build and options
+    double checksum = 0.0;
+    int contacts = 0;
+    for(const FVehicleSimulation& vehicle : vehicles)
+    {
+        checksum += vehicle.Drivetrain.EngineRPM + vehicle.Drivetrain.TrackLeftAngVel + vehicle.Drivetrain.TrackRightAngVel;
+        checksum += vehicle.BodyForces.Force.Z * 1.e-6;
+        contacts += vehicle.NumContacts;
+    }
+
+    const double totalNs = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(endTime - startTime).count();
+    const double vehicleTicks = (double)options.Vehicles * options.Ticks;
+    const double nsPerVehicleTick = totalNs / vehicleTicks;
+    const double vehicleTicksPerSecond = vehicleTicks / (totalNs * 1.e-9);
+    const double wheelTicksPerSecond = vehicleTicksPerSecond * (options.Wheels / 2) * 2;
+
+    std::printf("vehicles %d, wheels %d, ticks %d, ground %s, lod %s\n", options.Vehicles, options.Wheels, options.Ticks, options.Ground.c_str(), options.Lod.c_str());
+    std::printf("  %.1f ns/vehicle-tick\n", nsPerVehicleTick);
+    std::printf("  %.0f vehicle-ticks/s, %.0f wheel-ticks/s\n", vehicleTicksPerSecond, wheelTicksPerSecond);
+    std::printf("  %.2f sweeps/vehicle-tick%s\n", sweeps / vehicleTicks, options.ReuseContacts ? " (contacts reused)" : "");
+    std::printf("  %lld allocations (%lld bytes) during measured ticks\n", allocations, allocatedBytes);
+    std::printf("  %d contacts on last tick, checksum %.6f\n", contacts, checksum);
+    if(options.Net)
+    {
+        std::printf("  %.2f bytes/vehicle-tick replicated as delta snapshots, %d mismatches\n", netBits / 8.0 / vehicleTicks, netMismatches);
+    }
+
+    if(recorder.IsOpen())
+    {
+        if(!recorder.Close())
+        {
+            std::fprintf(stderr, "cannot write %s\n", options.RecordPath.c_str());
+            return 1;
+        }
+        std::printf("  %d ticks recorded to %s (recording slows every tick)\n", options.WarmupTicks + options.Ticks, options.RecordPath.c_str());
+    }
+
+    if(!options.JsonPath.empty())
+    {
+        FILE* file = std::fopen(options.JsonPath.c_str(), "w");
+        if(!file)
+        {
+            std::fprintf(stderr, "cannot write %s\n", options.JsonPath.c_str());
+            return 1;
+        }
+
+        std::fprintf(file,
+            "{\n"
+            "  \"benchmark\": \"drivetrain\",\n"
+            "  \"vehicles\": %d,\n"
+            "  \"wheels\": %d,\n"
+            "  \"ticks\": %d,\n"
+            "  \"ground\": \"%s\",\n"
+            "  \"lod\": \"%s\",\n"
+            "  \"reuse_contacts\": %s,\n"
+            "  \"sweeps_per_vehicle_tick\": %.3f,\n"
+            "  \"ns_per_vehicle_tick\": %.3f,\n"
+            "  \"vehicle_ticks_per_second\": %.1f,\n"
+            "  \"wheel_ticks_per_second\": %.1f,\n"
+            "  \"allocations\": %lld,\n"
+            "  \"allocated_bytes\": %lld,\n"
+            "  \"contacts\": %d,\n"
+            "  \"checksum\": %.6f\n"
+            "}\n",
+            options.Vehicles, options.Wheels, options.Ticks, options.Ground.c_str(), options.Lod.c_str(),
+            options.ReuseContacts ? "true" : "false", sweeps / vehicleTicks,
+            nsPerVehicleTick, vehicleTicksPerSecond, wheelTicksPerSecond,
+            allocations, allocatedBytes, contacts, checksum);
+        std::fclose(file);
+    }
+
+    if(!options.TracePath.empty())
+    {
+        if(!traceWriter.Write(options.TracePath.c_str()))
+        {
+            std::fprintf(stderr, "cannot write %s\n", options.TracePath.c_str());
+            return 1;
+        }
+        std::printf("  %d trace events written to %s\n", traceWriter.NumEvents(), options.TracePath.c_str());
+    }
+
+    return 0;
+}
@@ -0,0 +1,510 @@
+// Headless checks of the TrackedCore, built by the root CMakeLists.txt (not part of the Unreal module).
+//
+// Every batched kernel promises to match its scalar reference bit for bit.
+// The checks run the kernel and the reference on the same random inputs,
+// sized to leave every remainder count behind the SIMD lanes, with NaN, inf
+// and signed zero mixed in. Built once per lane width the compiler offers.
+// The snapshot codec is checked by writing and reading snapshots back, the
+// track path by moving one wheel and comparing the links before and after.
+
+#include "Core/TrackedFriction.h"
+#include "Core/TrackedNetState.h"
+#include "Core/TrackedSuspensionKernel.h"
+#include "Core/TrackedTrackPath.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace
+{
+    // ctest SKIP_RETURN_CODE, for AVX2 builds on CPUs without AVX2
+    const int SkipReturnCode = 77;
+
+    int GFailures = 0;
+
+    /// @brief Small deterministic generator, same sequence on every platform
+    struct FRandom
+    {
+        std::uint32_t State = 0x9E3779B9u;
+
+        std::uint32_t Next()
+        {
+            State ^= State << 13;
+            State ^= State >> 17;
+            State ^= State << 5;
+            return State;
+        }
+
+        float Range(float min, float max)
+        {
+            return min + (max - min) * (float)(Next() >> 8) / (float)(1 << 24);
+        }
+    };
+
+    /// @brief Same bits, or NaN on both sides (NaN payloads are not part of the contract)
+    bool sameFloat(float a, float b)
+    {
+        if(std::isnan(a) || std::isnan(b))
+        {
+            return std::isnan(a) && std::isnan(b);
+        }
+        std::uint32_t bitsA, bitsB;
+        std::memcpy(&bitsA, &a, sizeof(float));
+        std::memcpy(&bitsB, &b, sizeof(float));
+        return bitsA == bitsB;
+    }
+
+    void expectSame(const char* check, const char* field, int count, int index, float batched, float scalar)
+    {
+        if(!sameFloat(batched, scalar))
+        {
+            GFailures++;
+            std::fprintf(stderr, "%s: %s[%d] of %d is %.9g, scalar %.9g\n", check, field, index, count, batched, scalar);
+        }
+    }
+
+    void expectTrue(const char* check, const char* condition, bool value)
+    {
+        if(!value)
+        {
+            GFailures++;
+            std::fprintf(stderr, "%s: expected %s\n", check, condition);
+        }
+    }
+
+    #define EXPECT_TRUE(check, condition) expectTrue(check, #condition, condition)
+
+    /// @brief Odd values batched kernels must pass the way the scalar path does
+    float specialValue(FRandom& random)
+    {
+        const float values[] = {
+            std::numeric_limits<float>::quiet_NaN(),
+            std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity(),
+            0.0f,
+            -0.0f,
+            std::numeric_limits<float>::denorm_min(),
+        };
+        return values[random.Next() % (sizeof(values) / sizeof(values[0]))];
+    }
+
+    /// @brief Random value, every eighth one replaced by a special value when asked
+    float sampleValue(FRandom& random, float min, float max, bool special)
+    {
+        if(special && random.Next() % 8 == 0)
+        {
+            return specialValue(random);
+        }
+        return random.Range(min, max);
+    }
+
+    void checkSuspensionKernel()
+    {
+        FRandom random;
+
+        // Every remainder 0-7 behind full lanes, with and without special values
+        for(int pass = 0; pass < 2; pass++)
+        {
+            const bool special = pass == 1;
+            for(int count = 0; count <= 3 * TRACKEDCORE_SIMD_WIDTH + 7; count++)
+            {
+                std::vector<float> length(count), newLength(count), previousLength(count), stiffness(count), damping(count);
+                for(int index = 0; index < count; index++)
+                {
+                    length[index] = sampleValue(random, 10.0f, 80.0f, special);
+                    // Past both ends of the travel so the clamp gets hit
+                    newLength[index] = sampleValue(random, -10.0f, 100.0f, special);
+                    previousLength[index] = sampleValue(random, -10.0f, 100.0f, special);
+                    stiffness[index] = sampleValue(random, 0.0f, 5.0e6f, special);
+                    damping[index] = sampleValue(random, 0.0f, 5.0e4f, special);
+                }
+                const float targetVelocity = special && count % 3 == 0 ? specialValue(random) : random.Range(-50.0f, 50.0f);
+                const float dt = special && count % 5 == 0 ? specialValue(random) : random.Range(0.001f, 0.05f);
+
+                // Guard past the end catches stores beyond count
+                std::vector<float> batched(count + 1, 123.0f), scalar(count + 1, 123.0f);
+                TrackedCore::calculateSuspensionForceMagnitudes(
+                    length.data(), newLength.data(), previousLength.data(), stiffness.data(), damping.data(),
+                    targetVelocity, dt, batched.data(), count);
+                TrackedCore::calculateSuspensionForceMagnitudesScalar(
+                    length.data(), newLength.data(), previousLength.data(), stiffness.data(), damping.data(),
+                    targetVelocity, dt, scalar.data(), count);
+
+                for(int index = 0; index <= count; index++)
+                {
+                    expectSame("suspension kernel", "ForceMagnitude", count, index, batched[index], scalar[index]);
+                }
+            }
+        }
+    }
+
+    TrackedCore::FVec3 sampleVec(FRandom& random, float size, bool special)
+    {
+        return TrackedCore::FVec3(
+            sampleValue(random, -size, size, special),
+            sampleValue(random, -size, size, special),
+            sampleValue(random, -size, size, special));
+    }
+
+    void checkContactFriction()
+    {
+        FRandom random;
+        TrackedCore::FFrictionContactBatch batched, scalar;
+
+        // Counts off the lane width on both sides, with and without special values
+        for(int pass = 0; pass < 2; pass++)
+        {
+            const bool special = pass == 1;
+            for(int count = 0; count <= 3 * TRACKEDCORE_SIMD_WIDTH + 3; count++)
+            {
+                // Hull yawed and pitched, contacts tilted around its up axis
+                const float yaw = random.Range(-3.14159f, 3.14159f);
+                const float pitch = random.Range(-0.5f, 0.5f);
+                TrackedCore::FFrictionSolveParams params;
+                params.Forward = TrackedCore::FVec3(std::cos(yaw) * std::cos(pitch), std::sin(yaw) * std::cos(pitch), std::sin(pitch));
+                params.Right = TrackedCore::FVec3(-std::sin(yaw), std::cos(yaw), 0.0f);
+                params.SlipToForce = random.Range(100.0f, 5000.0f);
+
+                batched.Resize(count);
+                for(int contact = 0; contact < count; contact++)
+                {
+                    TrackedCore::FVec3 normal = TrackedCore::safeNormal(TrackedCore::FVec3(random.Range(-0.5f, 0.5f), random.Range(-0.5f, 0.5f), 1.0f));
+                    TrackedCore::FVec3 slip = sampleVec(random, 500.0f, special);
+                    // Degenerate slips: none at all, or only along the normal
+                    switch(random.Next() % 6)
+                    {
+                    case 0: slip = TrackedCore::FVec3(); break;
+                    case 1: slip = normal * random.Range(-100.0f, 100.0f); break;
+                    default: break;
+                    }
+
+                    TrackedCore::FSurfaceParams surface;
+                    surface.MuXStatic = sampleValue(random, 0.1f, 1.5f, special);
+                    surface.MuYStatic = sampleValue(random, 0.1f, 1.5f, special);
+                    surface.MuXKinetic = random.Range(0.1f, 1.0f);
+                    surface.MuYKinetic = random.Range(0.1f, 1.0f);
+                    surface.RollingFrictionCoef = random.Range(0.0f, 0.1f);
+
+                    batched.Set(contact, contact, normal, slip, sampleVec(random, 2.0e5f, special), sampleVec(random, 5.0e4f, special), surface);
+                }
+                scalar = batched;
+
+                TrackedCore::solveContactFriction(batched, params);
+                TrackedCore::solveContactFrictionScalar(scalar, params);
+
+                for(int contact = 0; contact < count; contact++)
+                {
+                    expectSame("contact friction", "ForceX", count, contact, batched.ForceX[contact], scalar.ForceX[contact]);
+                    expectSame("contact friction", "ForceY", count, contact, batched.ForceY[contact], scalar.ForceY[contact]);
+                    expectSame("contact friction", "ForceZ", count, contact, batched.ForceZ[contact], scalar.ForceZ[contact]);
+                    expectSame("contact friction", "FrictionAlongForward", count, contact, batched.FrictionAlongForward[contact], scalar.FrictionAlongForward[contact]);
+                    expectSame("contact friction", "WheelLoad", count, contact, batched.WheelLoad[contact], scalar.WheelLoad[contact]);
+                }
+            }
+        }
+    }
+
+    TrackedCore::FSuspensionStore makeNetTestStore()
+    {
+        TrackedCore::FSuspensionStore store;
+        TrackedCore::FSuspensionUnitSetup setup;
+        setup.Length = 40.0f;
+        for(int unit = 0; unit < 10; unit++)
+        {
+            store.Add(unit < 5 ? TrackedCore::ETrackSide::Left : TrackedCore::ETrackSide::Right, setup);
+        }
+        for(int unit = 0; unit < store.Num(); unit++)
+        {
+            store.PreviousLength[unit] = 40.0f * (float)unit / (float)store.Num();
+        }
+        return store;
+    }
+
+    /// @return result of writing snapshot (against baseline if set) and reading it back against history
+    TrackedCore::ENetSnapshotRead roundTripSnapshot(
+        const TrackedCore::FVehicleNetSnapshot& snapshot,
+        const TrackedCore::FVehicleNetSnapshot* baseline,
+        const TrackedCore::FNetSnapshotHistory& history,
+        const TrackedCore::FNetQuantization& quantization,
+        TrackedCore::FVehicleNetSnapshot& outSnapshot,
+        int* outBits = nullptr)
+    {
+        TrackedCore::FNetBitWriter writer;
+        TrackedCore::writeNetSnapshot(writer, snapshot, baseline, quantization);
+        if(outBits)
+        {
+            *outBits = writer.GetNumBits();
+        }
+        TrackedCore::FNetBitReader reader(writer.GetBytes().data(), writer.GetNumBits());
+        return TrackedCore::readNetSnapshot(reader, history, quantization, outSnapshot);
+    }
+
+    void checkNetSnapshot()
+    {
+        using TrackedCore::ENetSnapshotRead;
+
+        const TrackedCore::FNetQuantization quantization;
+        TrackedCore::FSuspensionStore store = makeNetTestStore();
+
+        TrackedCore::FNetVehicleState state;
+        state.TrackLeftAngVel = 12.5f;
+        state.TrackRightAngVel = -3.25f;
+        state.Throttle = 0.75f;
+        state.EngineRPM = 2400.0f;
+        state.InputLeft = 1.0f;
+        state.InputRight = -0.5f;
+        state.Gear = 2;
+        state.bReverse = true;
+
+        // Full snapshot, read without any baseline
+        TrackedCore::FVehicleNetSnapshot full;
+        TrackedCore::quantizeNetState(state, store, quantization, full);
+        full.Sequence = 100;
+        full.LastInput = 42;
+
+        TrackedCore::FNetSnapshotHistory history;
+        TrackedCore::FVehicleNetSnapshot received;
+        int fullBits = 0;
+        EXPECT_TRUE("net full", roundTripSnapshot(full, nullptr, history, quantization, received, &fullBits) == ENetSnapshotRead::Ok);
+        EXPECT_TRUE("net full", received.Sequence == full.Sequence && received.IsStateEqual(full));
+
+        TrackedCore::FNetVehicleState decoded;
+        TrackedCore::FSuspensionStore decodedStore = makeNetTestStore();
+        TrackedCore::dequantizeNetState(received, quantization, decoded, decodedStore);
+        EXPECT_TRUE("net full", std::fabs(decoded.TrackLeftAngVel - state.TrackLeftAngVel) < 0.01f);
+        EXPECT_TRUE("net full", std::fabs(decoded.EngineRPM - state.EngineRPM) < 10.0f);
+        EXPECT_TRUE("net full", decoded.InputLeft == 1.0f && std::fabs(decoded.InputRight + 0.5f) < 0.01f);
+        EXPECT_TRUE("net full", decoded.Gear == 2 && decoded.bReverse && !decoded.bAsleep);
+        EXPECT_TRUE("net full", std::fabs(decodedStore.PreviousLength[3] - store.PreviousLength[3]) < 1.0f);
+        history.Add(received);
+
+        // Delta against the received snapshot, one value and one unit changed
+        TrackedCore::FVehicleNetSnapshot next = full;
+        next.Sequence = 101;
+        next.Throttle = 3;
+        next.SuspensionLength[7] = 60;
+        int deltaBits = 0;
+        EXPECT_TRUE("net delta", roundTripSnapshot(next, &full, history, quantization, received, &deltaBits) == ENetSnapshotRead::Ok);
+        EXPECT_TRUE("net delta", received.Sequence == next.Sequence && received.IsStateEqual(next));
+        EXPECT_TRUE("net delta", deltaBits < fullBits / 2);
+
+        // Delta against a snapshot the receiver never got leaves the output alone
+        TrackedCore::FVehicleNetSnapshot missing = full;
+        missing.Sequence = 90;
+        TrackedCore::FVehicleNetSnapshot untouched = received;
+        EXPECT_TRUE("net missing baseline", roundTripSnapshot(next, &missing, history, quantization, received) == ENetSnapshotRead::MissingBaseline);
+        EXPECT_TRUE("net missing baseline", received.Sequence == untouched.Sequence && received.IsStateEqual(untouched));
+
+        // Cut short, the stream is corrupt rather than missing its baseline
+        TrackedCore::FNetBitWriter writer;
+        TrackedCore::writeNetSnapshot(writer, next, &full, quantization);
+        TrackedCore::FNetBitReader truncated(writer.GetBytes().data(), 20);
+        EXPECT_TRUE("net truncated", TrackedCore::readNetSnapshot(truncated, history, quantization, received) == ENetSnapshotRead::Corrupt);
+
+        // Sequence wrap: 0 follows 65535, deltas across the wrap still find their baseline
+        EXPECT_TRUE("net wrap", TrackedCore::isNewerSequence(0, 65535));
+        EXPECT_TRUE("net wrap", !TrackedCore::isNewerSequence(65535, 0));
+        EXPECT_TRUE("net wrap", TrackedCore::isNewerSequence(10, 65530));
+        EXPECT_TRUE("net wrap", TrackedCore::needsFullNetSnapshot(0, 65535));
+        TrackedCore::FVehicleNetSnapshot beforeWrap = full;
+        beforeWrap.Sequence = 65535;
+        history.Add(beforeWrap);
+        TrackedCore::FVehicleNetSnapshot afterWrap = next;
+        afterWrap.Sequence = 0;
+        EXPECT_TRUE("net wrap", roundTripSnapshot(afterWrap, &beforeWrap, history, quantization, received) == ENetSnapshotRead::Ok);
+        EXPECT_TRUE("net wrap", received.Sequence == 0 && received.IsStateEqual(afterWrap));
+
+        // Baselines drop out once the history is full
+        for(int sequence = 1; sequence <= TrackedCore::FNetSnapshotHistory::Capacity; sequence++)
+        {
+            TrackedCore::FVehicleNetSnapshot filler = full;
+            filler.Sequence = (uint16_t)sequence;
+            history.Add(filler);
+        }
+        EXPECT_TRUE("net stale baseline", roundTripSnapshot(afterWrap, &beforeWrap, history, quantization, received) == ENetSnapshotRead::MissingBaseline);
+
+        // NaN and inf go out as zero, a zero RPM range as well
+        TrackedCore::FNetVehicleState broken;
+        broken.TrackLeftAngVel = std::numeric_limits<float>::quiet_NaN();
+        broken.TrackRightAngVel = std::numeric_limits<float>::infinity();
+        broken.Throttle = std::numeric_limits<float>::quiet_NaN();
+        broken.EngineRPM = 2400.0f;
+        broken.InputLeft = -std::numeric_limits<float>::infinity();
+        TrackedCore::FNetQuantization noRPM;
+        noRPM.MaxEngineRPM = 0.0f;
+        TrackedCore::FVehicleNetSnapshot brokenSnapshot;
+        TrackedCore::quantizeNetState(broken, store, noRPM, brokenSnapshot);
+        TrackedCore::dequantizeNetState(brokenSnapshot, noRPM, decoded, decodedStore);
+        EXPECT_TRUE("net non-finite", decoded.TrackLeftAngVel == 0.0f && decoded.TrackRightAngVel == 0.0f);
+        EXPECT_TRUE("net non-finite", decoded.Throttle == 0.0f && decoded.EngineRPM == 0.0f && decoded.InputLeft == 0.0f);
+        EXPECT_TRUE("net non-finite", TrackedCore::quantizeNetInput(std::numeric_limits<float>::quiet_NaN()) == TrackedCore::quantizeNetInput(0.0f));
+    }
+
+    /// @brief Left track loop around three wheels, started at firstPoint of the unrotated order
+    /// @details Points 3, 4 and 5 of the unrotated order lie under the wheels of units 2, 1 and 0.
+    void buildTestTrackPath(int firstPoint, TrackedCore::FSuspensionStore& outStore, TrackedCore::FTrackPath& outPath)
+    {
+        TrackedCore::FSuspensionUnitSetup setup;
+        setup.Length = 50.0f;
+        setup.Radius = 20.0f;
+        for(int unit = 0; unit < 3; unit++)
+        {
+            setup.RootLocation = TrackedCore::FVec3(-100.0f + 100.0f * (float)unit, 0.0f, 0.0f);
+            outStore.Add(TrackedCore::ETrackSide::Left, setup);
+        }
+
+        // Forward along the top, down the front, back under the wheels
+        const TrackedCore::FVec3 loop[] = {
+            TrackedCore::FVec3(-150.0f, 0.0f, 20.0f),
+            TrackedCore::FVec3(150.0f, 0.0f, 20.0f),
+            TrackedCore::FVec3(170.0f, 0.0f, -40.0f),
+            TrackedCore::FVec3(100.0f, 0.0f, -70.0f),
+            TrackedCore::FVec3(0.0f, 0.0f, -70.0f),
+            TrackedCore::FVec3(-100.0f, 0.0f, -70.0f),
+            TrackedCore::FVec3(-170.0f, 0.0f, -40.0f),
+        };
+        const int numPoints = (int)(sizeof(loop) / sizeof(loop[0]));
+
+        std::vector<TrackedCore::FVec3> points(numPoints);
+        for(int point = 0; point < numPoints; point++)
+        {
+            points[point] = loop[(firstPoint + point) % numPoints];
+        }
+        outPath.Build(points.data(), nullptr, numPoints, 8);
+    }
+
+    bool sameLink(const TrackedCore::FTrackLinkTransform& a, const TrackedCore::FTrackLinkTransform& b)
+    {
+        return sameFloat(a.Location.X, b.Location.X) && sameFloat(a.Location.Y, b.Location.Y) && sameFloat(a.Location.Z, b.Location.Z)
+            && sameFloat(a.Rotation.X, b.Rotation.X) && sameFloat(a.Rotation.Y, b.Rotation.Y)
+            && sameFloat(a.Rotation.Z, b.Rotation.Z) && sameFloat(a.Rotation.W, b.Rotation.W);
+    }
+
+    bool inLoopRange(const TrackedCore::FTrackLoopRange& range, int item, int numItems)
+    {
+        return (item - range.First + numItems) % numItems < range.Count;
+    }
+
+    /// @brief Lift the middle wheel: only its two segments are re-solved, links elsewhere keep their bits
+    void checkTrackPathUpdate(const char* check, int firstPoint)
+    {
+        TrackedCore::FSuspensionStore store;
+        TrackedCore::FTrackPath path;
+        buildTestTrackPath(firstPoint, store, path);
+        const int numSegments = path.NumSegments();
+        const int middlePoint = (4 - firstPoint + numSegments) % numSegments;
+
+        TrackedCore::FTrackPathBinding binding;
+        TrackedCore::bindTrackPath(path, store, TrackedCore::ETrackSide::Left, 1.0f, binding);
+        EXPECT_TRUE(check, binding.Unit[middlePoint] == 1);
+        EXPECT_TRUE(check, binding.Unit[(middlePoint + 3) % numSegments] < 0);
+
+        // Nothing moved yet
+        EXPECT_TRUE(check, TrackedCore::updateTrackPath(path, binding, store, 0.25f).IsEmpty());
+
+        const int numLinks = 40;
+        const float phase = 13.0f;
+        const float outwardOffset = 2.0f;
+        std::vector<TrackedCore::FTrackLinkTransform> before(numLinks);
+        TrackedCore::placeTrackLinks(path, phase, numLinks, outwardOffset, TrackedCore::FTrackLoopRange(0, numLinks), before.data());
+        const std::vector<TrackedCore::FVec3> locationsBefore = path.Location;
+
+        store.PreviousLength[1] = 40.0f;
+        const TrackedCore::FTrackLoopRange segments = TrackedCore::updateTrackPath(path, binding, store, 0.25f);
+        EXPECT_TRUE(check, segments.First == (middlePoint + numSegments - 1) % numSegments && segments.Count == 2);
+        EXPECT_TRUE(check, std::fabs(path.Points[middlePoint].Z + 60.0f) < 1e-4f);
+
+        // Samples of the two segments moved, the others kept their bits
+        const int samplesPerSegment = path.SamplesPerSegment + 1;
+        for(int segment = 0; segment < numSegments; segment++)
+        {
+            bool same = true;
+            for(int sample = segment * samplesPerSegment; sample < (segment + 1) * samplesPerSegment; sample++)
+            {
+                same = same && sameFloat(path.Location[sample].X, locationsBefore[sample].X) && sameFloat(path.Location[sample].Z, locationsBefore[sample].Z);
+            }
+            if(same == inLoopRange(segments, segment, numSegments))
+            {
+                GFailures++;
+                std::fprintf(stderr, "%s: segment %d of %d %s\n", check, segment, numSegments, same ? "not re-solved" : "changed outside the range");
+            }
+        }
+
+        std::vector<TrackedCore::FTrackLinkTransform> after(numLinks);
+        TrackedCore::placeTrackLinks(path, phase, numLinks, outwardOffset, TrackedCore::FTrackLoopRange(0, numLinks), after.data());
+
+        // Links off the re-solved segments did not move
+        const TrackedCore::FTrackLoopRange links = TrackedCore::linksOnSegments(path, phase, numLinks, segments);
+        EXPECT_TRUE(check, !links.IsEmpty() && links.Count < numLinks);
+        int movedLinks = 0;
+        for(int link = 0; link < numLinks; link++)
+        {
+            const bool same = sameLink(before[link], after[link]);
+            movedLinks += same ? 0 : 1;
+            if(!same && !inLoopRange(links, link, numLinks))
+            {
+                GFailures++;
+                std::fprintf(stderr, "%s: link %d moved outside links [%d, +%d)\n", check, link, links.First, links.Count);
+            }
+        }
+        EXPECT_TRUE(check, movedLinks > 0);
+
+        // Placing only the dirty links lands them where the full loop does
+        std::vector<TrackedCore::FTrackLinkTransform> dirty(links.Count);
+        TrackedCore::placeTrackLinks(path, phase, numLinks, outwardOffset, links, dirty.data());
+        for(int link = 0; link < links.Count; link++)
+        {
+            const TrackedCore::FTrackLinkTransform& full = after[(links.First + link) % numLinks];
+            EXPECT_TRUE(check, TrackedCore::distance(dirty[link].Location, full.Location) < 1e-2f);
+        }
+
+        // Neighbouring links stay about one spacing apart, across the seam too
+        const float spacing = path.GetLength() / (float)numLinks;
+        for(int link = 0; link < numLinks; link++)
+        {
+            const float gap = TrackedCore::distance(after[link].Location, after[(link + 1) % numLinks].Location);
+            if(gap < spacing * 0.5f || gap > spacing * 1.25f)
+            {
+                GFailures++;
+                std::fprintf(stderr, "%s: links %d and %d are %.3f apart, spacing %.3f\n", check, link, (link + 1) % numLinks, gap, spacing);
+            }
+        }
+    }
+
+    void checkTrackPath()
+    {
+        checkTrackPathUpdate("track path", 0);
+        // Middle wheel on the first point, its segments are the last and the first
+        checkTrackPathUpdate("track path seam", 4);
+    }
+
+    bool isSimdSupported()
+    {
+#if defined(TRACKEDCORE_SIMD_AVX2) && (defined(__GNUC__) || defined(__clang__))
+        return __builtin_cpu_supports("avx2");
+#else
+        return true;
+#endif
+    }
+}
+
+int main()
+{
+    if(!isSimdSupported())
+    {
+        std::printf("CPU lacks the lanes this build was compiled for, skipped\n");
+        return SkipReturnCode;
+    }
+
+    checkSuspensionKernel();
+    checkContactFriction();
+    checkNetSnapshot();
+    checkTrackPath();
+
+    std::printf("lane width %d, %d failures\n", TRACKEDCORE_SIMD_WIDTH, GFailures);
+    return GFailures == 0 ? 0 : 1;
+}